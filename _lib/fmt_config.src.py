@@ -40,10 +40,12 @@ def stringify(x) :
 
 
 StdAttrs = {
-	'disk_date_precision' : float
+	'cgroup'              : str
+,	'disk_date_precision' : float
 ,	'file_sync'           : str
 ,	'heartbeat'           : float
 ,	'heartbeat_tick'      : float
+,	'job_relay'           : bool
 ,	'link_support'        : str
 ,	'local_admin_dir'     : str
 ,	'max_dep_depth'       : int
@@ -51,12 +53,15 @@ StdAttrs = {
 ,	'network_delay'       : float
 ,	'nice'                : int
 ,	'path_max'            : int
+,	'predict_resources'   : bool
 ,	'sub_repos'           : tuple
 ,	'req_start_proc'      : fmt_callable
 ,	'req_end_proc'        : fmt_callable
 ,	'server_start_proc'   : fmt_callable
 ,	'server_end_proc'     : fmt_callable
 ,	'system_tag_proc'     : lambda f:fmt_callable(f,'system_tag')
+,	'tmp_fs'              : bool
+,	'watch_deps'          : bool
 ,	'backends'            : stringify
 ,	'caches'              : stringify
 ,	'codecs'              : stringify
@@ -29,12 +29,14 @@ def _system_tag() :             # by default re-read Lmakefile as soon as the ex
 # /!\ default values must stay in sync with src/lmake_server/config.hh
 config = pdict(
 	disk_date_precision = 0.010                             # in seconds, precisions of dates on disk, must account for date granularity and date discrepancy between executing hosts and disk servers
+#,	cgroup              = '/sys/fs/cgroup/lmake'            # cgroup v2 dir (delegated to user) under which each job is run in its own cgroup, for accurate accounting and to enforce mem & cpu resources
 ,	file_sync           = 'dir'                             # method used to ensure real close-to-open file synchronization :
 #	                                                        # - 'none' or None : none
 #	                                                        # - 'dir'          : close dir after write, open dir before read
 #	                                                        # - 'sync'         : call fsync after write
 ,	heartbeat           = 10                                # in seconds, minimum interval between 2 heartbeat checks (and before first one) for the same job (no heartbeat if None)
 ,	heartbeat_tick      = 0.1                               # in seconds, minimum internval between 2 heartbeat checks (globally)                             (no heartbeat if None)
+,	job_relay           = False                             # if True, remote jobs report to server through a single connection per host rather than one per message
 ,	link_support        = 'Full'                            # symlinks are supported. Other values are 'None' (no symlink support) or 'File' (symlink to file only support)
 #,	local_admin_dir     = '/path/to/local/disk/LMAKE_LOCAL' # directory in which to store data that are private to the server (not accessed by remote executing hosts) (default is within LMAKE dir)
 #	                                                        # open-lmake ensures unicity between repos, so a hard-coded value is ok
@@ -44,6 +46,7 @@ config = pdict(
 	#                                                       # too low, there may be spurious lost jobs and there may be messages about date discrepancies between hosts
 	#                                                       # too high, tool reactivity may rarely suffer
 #,	nice                = 0                                 # nice value to apply to all jobs
+,	predict_resources   = False                             # if True, jobs are submitted with cpu & mem predicted from their history rather than with declared resources
 ,	path_max            = 200                               # max path length, smaller values make debugging easier (if None, not activated)
 ,	sub_repos           = []                                # list of sub_repos
 #,	req_start_proc      = my_proc                           # executed at start of each lmake command
@@ -51,6 +54,8 @@ config = pdict(
 #,	server_start_proc   = my_proc                           # executed at start of lmake_server
 #,	server_end_proc     = my_proc                           # executed at end   of lmake_server
 ,	system_tag_proc     = _system_tag                       # force config re-read if the result of this function changes
+,	tmp_fs              = False                             # if True, tmp dir of jobs declaring a tmp resource is a tmpfs of that size
+,	watch_deps          = False                             # if True, jobs are killed and rerun as soon as a dep they have read is modified
 ,	backends = pdict(                                       # PER_BACKEND : provide a default configuration for each backend
 		local = pdict(                                      # entries mention the total availability of resources
 			cpu =     _cpu                                  # total number of cpus available for the process, and hence for all jobs launched locally
@@ -66,6 +71,7 @@ config = pdict(
 	#	,	n_max_queued_jobs = 10                                # max number of queued jobs for a given set of asked resources
 	#	,	repo_key          = _osp.basename(_os.getcwd())       # prefix used before job name to name slurm jobs (this is the default if not specified)
 	#	,	root              = '/opt/sge'                        # root directory of the SGE installation
+	#	,	use_arrays        = True                              # if True (default is False), jobs with identical resources launched together are submitted as an array job
 	#	,	cpu_resource      = 'cpu'                             # resource used to require cpus                 (e.g. qsub -l cpu=1   to require 1 cpu), not managed if not specified
 	#	,	mem_resource      = 'mem'                             # resource used to require memory         in MB (e.g. qsub -l mem=10  to require 10 MB), not managed if not specified
 	#	,	tmp_resource      = 'tmp'                             # resource used to require tmp disk space in MB (e.g. qsub -l tmp=100 to require 100MB), not managed if not specified
@@ -77,6 +83,7 @@ config = pdict(
 	#	,	lib_slurm         = '/usr/lib/slurm.so'               # slurm dynamic lib (this is a typical default value if not specified)
 	#	,	n_max_queued_jobs = 10                                # max number of queued jobs for a given set of asked resources
 	#	,	repo_key          = _osp.basename(_os.getcwd())       # prefix used before job name to name slurm jobs
+	#	,	use_arrays        = True                              # if True (default is False), jobs with identical rounded resources launched together are submitted as a job array
 	#	,	use_nice          = True                              # if True (default is False), nice value is used to automatically prioritize jobs between repositories
 	#		                                                      # requires slurm configuration collaboration
 	#	)
@@ -117,6 +117,7 @@ However, sometimes it is practical to have the output while jobs are running.
 Generating such output for all jobs would produce an intermixed flow of characters of all jobs running in parallel making such an output unreadable.
 When this option is used, only the jobs directly producing the asked targets have their output generated on the output of B_(lmake).
 Because most of the time there is a single target, this ensures that there is a single job generating its output, avoiding the intermixing problem.
+Output is transmitted by whole lines, and lines produced in quick succession are grouped so that very verbose jobs do not overload the server.
 
 Item(B_(-N) I_(nice_val),B_(--nice)=I_(nice_val))
 Apply the specified nice value to all jobs.
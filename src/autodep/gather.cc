@@ -139,6 +139,17 @@ void Gather::new_access( Fd fd , PD pd , ::string&& file , AccessDigest ad , DI
 		if (+c) _user_trace( pd , c , ces , f ) ;
 		Trace("new_access", fd , STR(is_new) , pd , ad , di , _parallel_id , c , ces , old_info , "->" , info , f ) ; // only trace if something changes
 	}
+	if ( +_dep_watch_fd && !old_info.accesses()[Access::Reg] ) _watch_dep(f,info) ;                                 // only try to watch once per dep
+}
+
+void Gather::_watch_dep( ::string const& file , AccessInfo const& info ) {
+	if ( !info.accesses()[Access::Reg]           ) return ;                                                           // only content modifications are watched
+	if ( info.first_write()<PD::Never            ) return ;                                                           // file is not a dep or will be written by job
+	if ( info.dep_info.exists()!=Yes             ) return ;                                                           // inotify cannot watch non-existing files
+	if ( _dep_watches.size()>=DepWatchMax        ) return ;
+	int wd = ::inotify_add_watch( _dep_watch_fd , file.c_str() , IN_MODIFY|IN_CLOSE_WRITE|IN_MOVE_SELF|IN_DELETE_SELF ) ;
+	if (wd<0) { Trace("watch_dep",file,StrErr()) ; return ; }                                                         // best effort, server will detect modification anyway
+	_dep_watches.try_emplace(wd,file) ;                                                                               // same wd is returned if file is watched through several names
 }
 
 void Gather::new_exec( PD pd , ::string const& exe , Comment c ) {
@@ -476,6 +487,7 @@ void Gather::drain_heartbeat() {
 
 void Gather::_send_to_server( JobMngtRpcReq const& jmrr ) {
 	Trace trace("_send_to_server",jmrr) ;
+	if ( +service_relay && send_to_relay(service_relay,false/*is_end*/,serialize(jmrr)) ) return ; // fall back to direct connection if relay is not available
 	//    vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 	try { OMsgBuf(jmrr).send(ClientSockFd(service_mngt)) ; } catch (::string const& e) { trace("no_server",e) ; throw ; }
 	//    ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
@@ -548,12 +560,13 @@ Fd Gather::_spawn_child() {
 	//
 	Trace trace("_spawn_child",child_stdin,child_stdout,child_stderr,method,autodep_env) ;
 	//
-	_add_env          = { {"LMAKE_AUTODEP_ENV",autodep_env} } ;                   // required even with method==None or ptrace to allow support (ldepend, lmake module, ...) to work
-	_child.as_session = as_session                            ;
-	_child.nice       = nice                                  ;
-	_child.stdin      = child_stdin                           ;
-	_child.stdout     = child_stdout                          ;
-	_child.stderr     = child_stderr                          ;
+	_add_env            = { {"LMAKE_AUTODEP_ENV",autodep_env} } ;                 // required even with method==None or ptrace to allow support (ldepend, lmake module, ...) to work
+	_child.as_session   = as_session                            ;
+	_child.cgroup_procs = cgroup_procs                          ;
+	_child.nice         = nice                                  ;
+	_child.stdin        = child_stdin                           ;
+	_child.stdout       = child_stdout                          ;
+	_child.stderr       = child_stderr                          ;
 	// PER_AUTODEP_METHOD : handle case
 Retry :
 	switch (method) {
@@ -623,13 +636,15 @@ Status Gather::_exec_child() {
 	Epoll<Kind>                 epoll             { New          } ;
 	Status                      status            = Status::New    ;
 	::map<PD,::pair<Fd,Jerr>>   delayed_jerrs     ;                     // events that analyze deps and targets are delayed until all accesses are processed to ensure complete info
-	size_t                      live_out_pos      = 0              ;
+	size_t                      live_out_pos      = 0              ;    // stdout has been sent as live output up to this pos
+	size_t                      live_out_end      = 0              ;    // stdout can be sent as live output up to this pos (i.e. up to last complete line)
 	::umap<Fd,ServerSlaveEntry> server_slaves     ;
 	::umap<Fd,JobSlaveEntry   > job_slaves        ;                     // Jerr's waiting for confirmation
 	PD                          end_timeout       = PD::Never      ;
 	PD                          end_child         = PD::Never      ;
 	PD                          end_kill          = PD::Never      ;
 	PD                          end_heartbeat     = PD::Never      ;    // heartbeat to probe server when waiting for it
+	PD                          end_live_out      = PD::Never      ;    // pending live output is sent by then
 	bool                        timeout_fired     = false          ;
 	size_t                      kill_step         = 0              ;
 	bool                        seen_mount_chroot = false          ;
@@ -639,6 +654,20 @@ Status Gather::_exec_child() {
 		if (status==Status::New) status = status_ ;                     // only record first status
 		if (+msg_              ) msg << add_nl<<msg_ ;
 	} ;
+	auto send_live_out = [&]() {
+		end_live_out = PD::Never ;
+		if (live_out_end<=live_out_pos) return ;
+		JobMngtRpcReq jmrr ;
+		jmrr.seq_id = seq_id                                                    ;
+		jmrr.job    = job                                                       ;
+		jmrr.proc   = JobMngtProc::LiveOut                                      ;
+		jmrr.txt    = stdout.substr( live_out_pos , live_out_end-live_out_pos ) ;
+		//vvvvvvvvvvvvvvvvvvv
+		_send_to_server(jmrr) ;
+		//^^^^^^^^^^^^^^^^^^^
+		trace("live_out",live_out_pos,live_out_end) ;
+		live_out_pos = live_out_end ;
+	} ;
 	auto kill = [&]( Status status_=Status::Killed , ::string const& msg={} , bool next_step=false ) {
 		trace("kill",STR(next_step),kill_step,STR(as_session),_child.pid,_wait) ;
 		if      (next_step             ) SWEAR_PROD(kill_step<=kill_sigs.size()) ;
@@ -689,6 +718,14 @@ Status Gather::_exec_child() {
 		}
 		open_fast_report_fd() ;
 	}
+	if (watch_deps) {
+		_dep_watch_fd = AcFd( ::inotify_init1(IN_NONBLOCK|IN_CLOEXEC) , true/*no_std*/ ) ;
+		if (+_dep_watch_fd) {
+			for( auto const& [f,ai] : accesses ) _watch_dep(f,ai) ;                     // deps accessed before start, e.g. static deps when there is no autodep
+			epoll.add_read( _dep_watch_fd , Kind::DepWatch , false/*wait*/ ) ;           // dep modifications are only a reason to stop early, not to wait
+			trace("read_dep_watch",_dep_watch_fd,_dep_watches.size()) ;
+		}
+	}
 	if (+server_master_fd) {
 		epoll.add_read(server_master_fd,Kind::ServerMaster) ;
 		trace("read_server_master",server_master_fd,"wait",_wait,+epoll) ;
@@ -723,6 +760,7 @@ Status Gather::_exec_child() {
 		if (now>=end_kill) {
 			kill( Status::Killed , {} , true/*next*/ ) ;
 		}
+		if (now>=end_live_out) send_live_out() ;
 		if ( now>=end_timeout && !timeout_fired ) {
 			_user_trace( now , Comment::Timeout ) ;
 			kill( Status::Timeout , "timeout after "+timeout.short_str() ) ;
@@ -746,8 +784,8 @@ Status Gather::_exec_child() {
 		bool  must_wait      = +epoll || +_wait ;
 		Pdate max_event_date = now              ;
 		if ( must_wait && !_wait[Kind::ChildStart] ) {
-			/**/                max_event_date = ::min({ end_child , end_kill , end_timeout , end_heartbeat }) ;
-			if (+delayed_jerrs) max_event_date = ::min(  max_event_date , delayed_jerrs.begin()->first       ) ;
+			/**/                max_event_date = ::min({ end_child , end_kill , end_timeout , end_heartbeat , end_live_out }) ;
+			if (+delayed_jerrs) max_event_date = ::min(  max_event_date , delayed_jerrs.begin()->first                      ) ;
 		}
 		::vector<Event> events = epoll.wait(max_event_date) ;
 		if (!events) {
@@ -818,20 +856,13 @@ Status Gather::_exec_child() {
 							stdout.append(buf_view) ;
 							if ( live_out && has_server )
 								if ( size_t pos = buf_view.rfind('\n')+1 ;  pos ) {
-									size_t        len  = old_sz + pos - live_out_pos ;
-									JobMngtRpcReq jmrr ;
-									jmrr.seq_id = seq_id                          ;
-									jmrr.job    = job                             ;
-									jmrr.proc   = JobMngtProc::LiveOut            ;
-									jmrr.txt    = stdout.substr(live_out_pos,len) ;
-									//vvvvvvvvvvvvvvvvvvv
-									_send_to_server(jmrr) ;
-									//^^^^^^^^^^^^^^^^^^^
-									trace("live_out",live_out_pos,len) ;
-									live_out_pos += len ;
+									live_out_end = old_sz + pos ;
+									if      (live_out_end-live_out_pos>=LiveOutMaxSz) send_live_out()                    ; // dont accumulate too much
+									else if (end_live_out==PD::Never                ) end_live_out = now + LiveOutDelay ; // coalesce chunks within a short window
 								}
 						}
 					} else {
+						if (kind==Kind::Stdout) send_live_out() ;                                                    // flush pending live output
 						epoll.del(false/*write*/,fd) ;
 						_wait &= ~kind ;
 						trace(kind,fd,"close","wait",_wait,+epoll) ;
@@ -860,6 +891,21 @@ Status Gather::_exec_child() {
 					if (+server_master_fd) epoll.dec() ;                         // idem for connections from server
 					trace(kind,fd,"close",status,"wait",_wait,+epoll) ;
 				} break ;
+				case Kind::DepWatch : {
+					alignas(struct inotify_event) char buf[4096] ;
+					for( ssize_t cnt ; (cnt=::read(fd,buf,sizeof(buf)))>0 ; )                                  // fd is non-blocking, read until exhausted
+						for( ssize_t i=0 ; i<cnt ; ) {
+							struct inotify_event const& ev = *reinterpret_cast<struct inotify_event const*>(buf+i) ;
+							i += sizeof(struct inotify_event) + ev.len ;
+							auto wit = _dep_watches.find(ev.wd) ; if (wit==_dep_watches.end()) continue ;
+							::string   const& f    = wit->second   ;
+							AccessInfo const& info = accesses.at(f) ;
+							if (info.first_write()<PD::Never) continue ;                                           // job wrote file after having read it, this is not a dep modification
+							bool modified = info.dep_info.is_a<DepInfoKind::Crc>() ? Crc(f)!=info.dep_info.crc() : FileSig(f)!=info.dep_info.sig() ;
+							trace(kind,fd,ev.mask,STR(modified),f) ;
+							if (modified) kill( Status::ChkDeps , cat("dep modified while job was running : ",f) ) ; // job will be rerun anyway, no need to wait for its end
+						}
+				} break ;
 				case Kind::JobMaster : {
 					SWEAR( fd==job_master_fd , fd,job_master_fd ) ;
 					Fd sfd = job_master_fd.accept().detach() ;
@@ -889,6 +935,10 @@ Status Gather::_exec_child() {
 							_user_trace( Comment::Kill , CommentExt::Reply ) ;
 							kill()                                           ;
 						break ;
+						case JobMngtProc::Suspend :                                                                                    // job is waiting for direct deps, let it release what it holds if asked to
+							trace("suspend",jmrr.sig) ;
+							if ( jmrr.sig && _child.pid>1 ) kill_process( _child.pid , jmrr.sig , as_session/*as_group*/ ) ;
+						break ;
 						case JobMngtProc::DepDirect  :
 						case JobMngtProc::DepVerbose : {
 							_n_server_req_pending-- ;
@@ -948,6 +998,7 @@ Status Gather::_exec_child() {
 							if (!live_out) {
 								live_out     = true                 ;
 								live_out_pos = stdout.rfind('\n')+1 ;
+								live_out_end = live_out_pos         ;
 							}
 							if ( live_out_pos && has_server ) {
 								JobMngtRpcReq jmrr ;
@@ -35,6 +35,7 @@ enum class GatherKind : uint8_t { // epoll events
 ,	JobSlave
 ,	ServerMaster
 ,	ServerSlave
+,	DepWatch                      // inotify events on deps read by job
 } ;
 
 enum class KillStep : uint8_t {
@@ -50,7 +51,10 @@ struct Gather {                                         // NOLINT(clang-analyzer
 	using Crc  = Hash::Crc     ;
 	using PD   = Time::Pdate   ;
 	using DI   = DepInfo       ;
-	static constexpr Time::Delay HeartbeatTick { 10 } ; // heartbeat to probe server when waiting for it, there may be 1000's job_exec's waiting for it, 100s seems a good compromize
+	static constexpr Time::Delay HeartbeatTick { 10    } ; // heartbeat to probe server when waiting for it, there may be 1000's job_exec's waiting for it, 100s seems a good compromize
+	static constexpr Time::Delay LiveOutDelay  { 0.050 } ; // live output is coalesced within this delay so that chatty jobs do not flood server with messages
+	static constexpr size_t      LiveOutMaxSz  = 1<<16   ; // live output is sent without waiting as soon as this size is reached
+	static constexpr size_t      DepWatchMax   = 1<<10   ; // max number of deps watched for modification, inotify watches are a per-user resource shared with other jobs
 	struct AccessInfo {
 		// cxtors & casts
 		AccessInfo() = default ;
@@ -171,11 +175,12 @@ public :
 		}
 	}
 private :
-	void                   _update_flags( bool drain_heartbeat          ) ;                     // update accesses to take star matches into account
-	::vector<AccessEntry*> _reorder     ( bool drain_heartbeat          ) ;                     // reorder accesses by first read access and suppress superfluous accesses
-	Fd                     _spawn_child (                               ) ;
-	Status                 _exec_child  (                               ) ;
-	void                   _trace_child ( Fd report_fd , ::latch* ready ) ;
+	void                   _update_flags( bool drain_heartbeat                      ) ;         // update accesses to take star matches into account
+	::vector<AccessEntry*> _reorder     ( bool drain_heartbeat                      ) ;         // reorder accesses by first read access and suppress superfluous accesses
+	Fd                     _spawn_child (                                           ) ;
+	Status                 _exec_child  (                                           ) ;
+	void                   _trace_child ( Fd report_fd , ::latch* ready             ) ;
+	void                   _watch_dep   ( ::string const& file , AccessInfo const& ) ;         // start watching file for modification if it is a dep
 	//
 	void _user_trace( PD pd , Comment c , CommentExts ces={} , ::string const& file={} ) const { if (user_trace) user_trace->emplace_back(pd,c,ces,file) ; }
 	void _user_trace(         Comment c , CommentExts ces={} , ::string const& file={} ) const { _user_trace( New , c , ces , file ) ;                     }
@@ -186,6 +191,7 @@ public :
 	::umap_s<AccessInfo>      accesses         ;
 	bool                      as_session       = false               ;                          // if true <=> process is launched in its own group
 	AutodepEnv                autodep_env      ;
+	Fd                        cgroup_procs     ;                                                // if valid, cgroup.procs file of the cgroup job is run in
 	Fd                        child_stdin      = Fd::Stdin           ;
 	Fd                        child_stderr     = Fd::Stderr          ;
 	Fd                        child_stdout     = Fd::Stdout          ;
@@ -207,17 +213,21 @@ public :
 	SeqId                     seq_id           = 0                   ;
 	ServerSockFd              server_master_fd ;
 	KeyedService              service_mngt     ;                                                // no server if empty
+	KeyedService              service_relay    ;                                                // if non-empty, messages are sent through per-host relay when possible
 	PD                        start_date       ;
 	bool                      started          = false               ;
 	::string                  stderr           ;                                                // contains child stderr if child_stderr==Pipe
 	::string                  stdout           ;                                                // contains child stdout if child_stdout==Pipe
 	Time::Delay               timeout          ;
 	::vector<UserTraceEntry>* user_trace       = nullptr             ;
+	bool                      watch_deps       = false               ;                          // if true, job is killed as soon as a dep it has read is modified
 	Atomic<int>               wstatus          ;
 private :
 	::array<::vmap<Re::RegExpr,::pair<PD,MatchFlags>>,2/*readdir*/> _star_matchess        ;     // apply flags to matching accesses (sorted : Target first, then non-Target)
 	::map_ss                                                        _add_env              ;
 	Child                                                           _child                ;
+	AcFd                                                            _dep_watch_fd         ;     // inotify fd watching deps if watch_deps
+	::umap<int/*wd*/,::string>                                      _dep_watches          ;     // maps inotify watches to deps
 	size_t                                                          _n_server_req_pending = 0 ;
 	NodeIdx                                                         _parallel_id          = 0 ; // id to identify parallel deps
 	::jthread                                                       _trace_thread         ;
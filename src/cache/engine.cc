@@ -10,15 +10,22 @@
 #include "cache_utils.hh"
 #include "engine.hh"
 
+using std::atomic_ref ;
+
 using namespace Disk ;
 using namespace Hash ;
 using namespace Py   ;
 using namespace Time ;
 
-CacheConfig g_cache_config ;
-DiskSz      g_reserved_sz  = 0                            ;
-::string    g_store_dir_s  = PRIVATE_ADMIN_DIR_S "store/" ;
-FileSync    g_file_sync    = {}/*garbage*/                ;
+CacheConfig                           g_cache_config ;
+DiskSz                                g_reserved_sz  = 0                            ;
+::string                              g_store_dir_s  = PRIVATE_ADMIN_DIR_S "store/" ;
+FileSync                              g_file_sync    = {}/*garbage*/                ;
+Mutex<MutexLvl::Cache,true/*Shared*/> g_cache_mutex  ;
+::vector<TenantConfig>                g_tenants      ;
+
+static Mutex<>        _g_accesses_mutex ;
+static ::vector<Crun> _g_accesses       ; // runs that have been hit but whose lru has not been updated yet
 
 CkeyFile      _g_key_file       ;
 CjobNameFile  _g_job_name_file  ;
@@ -109,6 +116,256 @@ float               RateCmp::s_rates[NRates] = {}      ;
 LruEntry*           RateCmp::s_lrus          = nullptr ;
 ::set<Rate,RateCmp> RateCmp::s_tab           ;
 
+// tenant occupancy is not stored but computed at init time and maintained as runs are created and victimized
+// when making room, runs from the most over-quota tenant are victimized first, within a limited scan of the global LRUs, and global LRU is used otherwise
+// hit/miss statistics are persistent and reset when tenant config changes
+
+static constexpr size_t MaxTenantScan = 1000 ; // max number of runs scanned to find a victim in an over-quota tenant
+
+static ::vector<DiskSz>                 _g_tenant_quotas   ;
+static ::vector<DiskSz>                 _g_tenant_szs      ;
+static ::umap<Ckey,Tenant>              _g_key_tenants     ;    // cache of key_tenant, erased when key is victimized
+static Store::RawFile<'=',size_t(1)<<16> _g_tenant_stats_file ;
+
+static Tenant _key_tenant(::string const& key) {
+	Tenant res     = 0 ;
+	size_t res_len = 0 ;
+	for( Tenant t : iota<Tenant>(1,g_tenants.size()) ) {
+		::string const& pfx = g_tenants[t].key_prefix ;
+		if ( pfx.size()>=res_len && key.starts_with(pfx) ) { res = t ; res_len = pfx.size() ; }
+	}
+	return res ;
+}
+
+Tenant key_tenant(Ckey key) {
+	auto [it,inserted] = _g_key_tenants.try_emplace(key) ;
+	if (inserted) it->second = _key_tenant(key.str()) ;
+	return it->second ;
+}
+
+DiskSz tenant_quota(Tenant t) { return _g_tenant_quotas[t] ; }
+DiskSz tenant_sz   (Tenant t) { return _g_tenant_szs   [t] ; }
+
+TenantStats const& tenant_stats(Tenant t) {
+	static TenantStats const s_empty ;
+	if ((t+1)*sizeof(TenantStats)>_g_tenant_stats_file.size) return s_empty ;   // read-only and no stats yet
+	return reinterpret_cast<TenantStats const*>(_g_tenant_stats_file.base)[t] ;
+}
+
+void tenant_record_download( Tenant t , CacheHitInfo hit_info ) {
+	if (!_g_tenant_stats_file.writable) return ;
+	TenantStats& stats = reinterpret_cast<TenantStats*>(_g_tenant_stats_file.base)[t] ;
+	if      (hit_info<=CacheHitInfo::Hit ) ::atomic_ref(stats.n_hits  )++ ;             // several readers may record concurrently
+	else if (hit_info>=CacheHitInfo::Miss) ::atomic_ref(stats.n_misses)++ ;             // Match is neither a hit nor a miss
+}
+
+static void _tenant_init( ::string const& stats_file , bool read_only ) {
+	uint64_t total_weight = 0 ;
+	for( TenantConfig const& tc : g_tenants ) total_weight += tc.weight ;
+	_g_tenant_quotas.clear() ;
+	for( TenantConfig const& tc : g_tenants )
+		if (tc.quota) _g_tenant_quotas.push_back( tc.quota                                                        ) ;
+		else          _g_tenant_quotas.push_back( ::max( g_cache_config.max_sz*tc.weight/total_weight , DiskSz(1) ) ) ;
+	//
+	_g_tenant_szs.assign(g_tenants.size(),0) ;
+	for( Crun r : lst<Crun>() ) {
+		CrunData const& rd = *r ; if (!rd) continue ;                                // run has been victimized
+		_g_tenant_szs[key_tenant(rd.key)] += rd.sz ;
+	}
+	//
+	_g_tenant_stats_file.init( stats_file , !read_only ) ;
+	if (read_only) return ;
+	bool ok = _g_tenant_stats_file.size>=g_tenants.size()*sizeof(TenantStats) ;
+	for( Tenant t : iota<Tenant>(g_tenants.size()) ) {
+		if (!ok) break ;
+		ok = tenant_stats(t).name_crc==+Crc(New,g_tenants[t].name) ;
+	}
+	if (ok) return ;
+	Trace trace("_tenant_init","reset_stats",g_tenants.size()) ;
+	_g_tenant_stats_file.clear( g_tenants.size()*sizeof(TenantStats) ) ;
+	::memset( _g_tenant_stats_file.base , 0 , _g_tenant_stats_file.size ) ;          // file may have kept old content
+	TenantStats* stats = reinterpret_cast<TenantStats*>(_g_tenant_stats_file.base) ;
+	for( Tenant t : iota<Tenant>(g_tenants.size()) ) stats[t].name_crc = +Crc(New,g_tenants[t].name) ;
+}
+
+// oldest run of the most over-quota tenant, if any can be found in a reasonable time
+static Crun _tenant_victim() {
+	::optional<Tenant> worst       ;
+	float              worst_ratio = 1 ;                                             // only consider tenants above their quota
+	for( Tenant t : iota<Tenant>(g_tenants.size()) ) {
+		float ratio = float(_g_tenant_szs[t]) / _g_tenant_quotas[t] ;
+		if (ratio>worst_ratio) { worst = t ; worst_ratio = ratio ; }
+	}
+	if (!worst) return {} ;
+	size_t n_scanned = 0 ;
+	for( Rate r : RateCmp::s_tab )                                                   // scan buckets in victimization order
+		for( Crun c=RateCmp::s_lrus[r].newer/*oldest*/ ; +c ; c=c->glb_lru.newer ) {
+			if (key_tenant(c->key)==*worst) return c  ;
+			if (++n_scanned>=MaxTenantScan) return {} ;
+		}
+	return {} ;
+}
+
+// stats are a header followed by key stats indexed by key
+// counters that may be updated by readers (with g_cache_mutex shared) are updated atomically, file is only expanded with g_cache_mutex exclusive
+
+static Store::RawFile<'=',size_t(1)<<32> _g_stats_file ;
+
+static CacheStats& _stats    () { return *reinterpret_cast<CacheStats*>(_g_stats_file.base                   ) ; }
+static KeyStats*   _key_stats() { return  reinterpret_cast<KeyStats  *>(_g_stats_file.base+sizeof(CacheStats)) ; }
+
+Delay LatencyHisto::avg() const {
+	uint64_t n_ = 0 ; for( uint64_t c : n ) n_ += c ;
+	if (!n_) return {} ;
+	return Delay( New , int64_t(total_ns/n_) ) ;
+}
+
+void LatencyHisto::record(Delay d) {
+	int64_t ns = ::max( d.val() , int64_t(0) )                                        ;
+	size_t  b  = ::min( size_t(::bit_width(uint64_t(ns/1000))) , size_t(NBuckets-1) ) ;
+	::atomic_ref(n[b])     ++     ;
+	::atomic_ref(total_ns) += ns  ;
+}
+
+static void _stats_init( ::string const& file , bool read_only ) {
+	_g_stats_file.init( file , !read_only ) ;
+	if ( read_only                                                                         ) return ;
+	if ( _g_stats_file.size>=sizeof(CacheStats) && _stats().version==CacheStats::Version ) return ;
+	Trace trace("_stats_init","reset") ;
+	_g_stats_file.clear(sizeof(CacheStats)) ;
+	::memset( _g_stats_file.base , 0 , _g_stats_file.size ) ; // file may have kept old content
+	_stats() = {} ;
+}
+
+CacheStats const& cache_stats() {
+	static CacheStats const s_empty ;
+	if (_g_stats_file.size<sizeof(CacheStats)) return s_empty ; // read-only and no stats yet
+	return _stats() ;
+}
+
+KeyStats const& key_stats(Ckey key) {
+	static KeyStats const s_empty ;
+	if (sizeof(CacheStats)+(+key+1)*sizeof(KeyStats)>_g_stats_file.size) return s_empty ;
+	return _key_stats()[+key] ;
+}
+
+void stats_new_key(Ckey key) {
+	if (!_g_stats_file.writable) return ;
+	_g_stats_file.expand( sizeof(CacheStats)+(+key+1)*sizeof(KeyStats) ) ; // expansion does not move base, so readers are not disturbed
+	_key_stats()[+key] = {} ;
+}
+
+void stats_record_download( Ckey key , CacheHitInfo hit_info , Delay d ) {
+	if (!_g_stats_file.writable) return ;
+	CacheStats& stats = _stats() ;
+	::atomic_ref(stats.n_downloads[+hit_info])++ ;
+	stats.download_time.record(d) ;
+	if ( sizeof(CacheStats)+(+key+1)*sizeof(KeyStats)>_g_stats_file.size ) return ; // key was created before stats were available
+	KeyStats& ks = _key_stats()[+key] ;
+	/**/                                 ::atomic_ref(ks.n_downloads)++ ;
+	if (hit_info<=CacheHitInfo::Hit) ::atomic_ref(ks.n_hits     )++ ;
+}
+
+void stats_record_upload( Ckey key , DiskSz sz ) {
+	if ( !_g_stats_file.writable                                             ) return ;
+	if ( sizeof(CacheStats)+(+key+1)*sizeof(KeyStats)>_g_stats_file.size ) return ;     // key was created before stats were available
+	KeyStats& ks = _key_stats()[+key] ;
+	ks.n_uploads   ++    ;                                                              // only called with g_cache_mutex exclusive
+	ks.uploaded_sz += sz ;
+}
+
+void stats_record_upload_reject() {
+	if (!_g_stats_file.writable) return ;
+	_stats().n_upload_rejects++ ;
+}
+
+// in order to answer most misses without searching the store, a Bloom filter is maintained, keyed by job and static dep crcs
+// static deps must match exactly for a hit unless their crc has been generalized, in which case a key with job only is recorded
+// bits are never reset on victimization, so filter is rebuilt from runs when too many items have been inserted
+// filter is a mere accelerator that can be rebuilt at any time, so it is not part of the cache format
+
+struct MissFilterHdr {
+	size_t n_bits  = 0 ; // always a power of 2
+	size_t n_items = 0 ; // items inserted since last rebuild
+} ;
+
+static constexpr uint8_t MissFilterNHashes     = 4     ; // with 8 bits per item, false positive rate is ~2.4%
+static constexpr size_t  MissFilterBitsPerItem = 8     ;
+static constexpr size_t  MissFilterMinBits     = 1<<20 ;
+
+static Store::RawFile<'=',size_t(1)<<32> _g_miss_filter_file ;
+
+static MissFilterHdr& _miss_filter_hdr () { return *reinterpret_cast<MissFilterHdr*>(_g_miss_filter_file.base                      ) ; }
+static uint64_t     * _miss_filter_bits() { return  reinterpret_cast<uint64_t     *>(_g_miss_filter_file.base+sizeof(MissFilterHdr)) ; }
+
+// we lose 1 bit of crc but we must manage errors and it does not desserv an additional field
+static Crc _err_crc( Crc crc , DepDigest const& dd , Accesses a ) {
+	if ( dd.err && a[Access::Err] ) return +crc |  CrcErr ;         // if not sensed, ignore error status (lmake would stop if not ignored anyway)
+	else                            return +crc & ~CrcErr ;
+}
+
+static uint64_t _miss_filter_key( Cjob job , ::optional<uint64_t> static_crcs ) { // static_crcs is the sum of static dep crcs, none if some are generalized
+	Xxh h ;
+	h += +job                    ;
+	h += bool(static_crcs)       ;
+	h += static_crcs.value_or(0) ;
+	return +h.digest() ;
+}
+
+static bool/*found*/ _miss_filter_access( uint64_t key , bool set ) {
+	size_t    msk  = _miss_filter_hdr().n_bits - 1 ;
+	uint64_t* bits = _miss_filter_bits()           ;
+	uint64_t  inc  = (key>>32|key<<32) | 1         ; // odd, hence positions are distinct
+	for( uint8_t i : iota(MissFilterNHashes) ) {
+		size_t   b = (key+i*inc) & msk   ;
+		uint64_t m = uint64_t(1)<<(b%64) ;
+		if      (set              ) bits[b/64] |= m ;
+		else if (!(bits[b/64]&m)) return false    ;
+	}
+	return true ;
+}
+
+static void _miss_filter_insert( Cjob job , ::span<Crc const> static_crcs ) {
+	::optional<uint64_t> sum = 0 ;
+	for( Crc c : static_crcs ) {
+		if (!Crc(+c&~(CrcOrNone|CrcErr)).valid()) { sum = {} ; break ; } // generalized crc, job only is recorded
+		*sum += +c ;
+	}
+	_miss_filter_access( _miss_filter_key(job,sum) , true/*set*/ ) ;
+	_miss_filter_hdr().n_items++ ;
+}
+
+static void _miss_filter_rebuild() {
+	size_t n_bits = MissFilterMinBits ;
+	while ( n_bits < 2*MissFilterBitsPerItem*CrunData::s_size() ) n_bits <<= 1 ;          // leave room for growth
+	Trace trace("_miss_filter_rebuild",CrunData::s_size(),n_bits) ;
+	_g_miss_filter_file.clear( sizeof(MissFilterHdr)+n_bits/8 ) ;
+	::memset( _g_miss_filter_file.base , 0 , sizeof(MissFilterHdr)+n_bits/8 ) ;           // file may have kept old content
+	_miss_filter_hdr().n_bits = n_bits ;
+	for( Crun r : lst<Crun>() ) {
+		CrunData const& rd = *r ; if (!rd) continue ;                                     // run has been victimized
+		_miss_filter_insert( rd.job , rd.dep_crcs.view().subspan(0,rd.job->n_statics) ) ;
+	}
+	trace("done",_miss_filter_hdr().n_items) ;
+}
+
+static void _miss_filter_record( Cjob job , CompileDigest const& compile_digest ) {
+	if (!_g_miss_filter_file) return ;
+	_miss_filter_insert( job , ::span(compile_digest.dep_crcs).subspan(0,compile_digest.n_statics) ) ;
+	if (_miss_filter_hdr().n_items*MissFilterBitsPerItem>_miss_filter_hdr().n_bits) _miss_filter_rebuild() ; // filter is saturated
+}
+
+bool/*may_hit*/ miss_filter_may_hit( Cjob job , ::vmap<StrId<CnodeIdx>,DepDigest> const& repo_deps ) {
+	if (!_g_miss_filter_file) return true ;                                                                                 // no filter available
+	uint64_t sum = 0 ;
+	for( auto const& [_,dd] : repo_deps )                                                                                   // compute static dep crcs as CompileDigest does
+		if (dd.dflags[Dflag::Static]) sum += +_err_crc( dd.crc() , dd , dd.dflags[Dflag::Full]?dd.accesses():Accesses() ) ;
+	return
+		_miss_filter_access( _miss_filter_key(job,sum) , false/*set*/ )
+	||	_miss_filter_access( _miss_filter_key(job,{} ) , false/*set*/ )
+	;
+}
+
 void cache_chk() {
 	Trace trace("cache_chk") ;
 	//
@@ -126,6 +383,28 @@ void cache_chk() {
 	trace("done") ;
 }
 
+static void _parse_tenants(Dict const& py_tenants) {
+	for( auto const& [py_name,py_tenant] : py_tenants ) {
+		TenantConfig tc ; tc.name = py_name.as_a<Str>() ;
+		throw_unless( +tc.name , "tenant name must not be empty" ) ;
+		for( auto const& [k,v] : ::vmap_ss(py_tenant.as_a<Dict>()) ) {
+			try {
+				switch (k[0]) {
+					case 'k' : if (k=="key_prefix") { tc.key_prefix = v                        ;                                                continue ; } break ;
+					case 'q' : if (k=="quota"     ) { tc.quota      = from_string_with_unit(v) ; throw_unless( tc.quota >0 , "must be positive" ) ; continue ; } break ;
+					case 'w' : if (k=="weight"    ) { tc.weight     = from_string<uint32_t>(v) ; throw_unless( tc.weight>0 , "must be positive" ) ; continue ; } break ;
+				DN}
+			} catch (::string const& e) {
+				throw cat("wrong value (",e,") for entry ",k," of tenant ",tc.name," : ",v) ;
+			}
+			throw cat("wrong key (",k,") for tenant ",tc.name) ;
+		}
+		throw_unless( +tc.key_prefix , "key_prefix must be defined for tenant ",tc.name ) ;
+		g_tenants.push_back(::move(tc)) ;
+	}
+	throw_unless( g_tenants.size()<=Max<Tenant> , "too many tenants : ",g_tenants.size()-1 ) ;
+}
+
 void cache_init( bool rescue , bool read_only ) {
 	Trace trace("cache_init",STR(rescue),STR(read_only)) ;
 	//
@@ -135,6 +414,7 @@ void cache_init( bool rescue , bool read_only ) {
 		Gil                  gil         ;
 		Ptr<Dict>            py_config   = py_run(config_fd.read()) ;
 		::optional<::uset_s> all         ;
+		g_tenants = { TenantConfig() } ;                                                      // default tenant
 		for( auto const& [py_k,py_v] : *py_config )
 			if (::string(py_k.as_a<Str>())=="__all__") {
 				all = ::uset_s() ;
@@ -153,6 +433,7 @@ void cache_init( bool rescue , bool read_only ) {
 					/**/       if (k=="max_runs_per_job") { ccfg.max_runs_per_job = from_string<uint16_t>(v) ; throw_unless( ccfg.max_runs_per_job>0 , "must be positive" ) ; continue ; } break ;
 					case 'p' : if (k=="perm"            ) { Fd::Stderr.write(cat("while configuring cache, perm is now automatic and deprecated : ",cwd_s(),rm_slash,'\n')) ; continue ; } break ;
 					case 's' : if (k=="size"            ) { ccfg.max_sz           = from_string_with_unit(v) ;                                                                continue ; } break ;
+					case 't' : if (k=="tenants"         ) { _parse_tenants( (*py_config)[k].as_a<Dict>() ) ;                                                                 continue ; } break ;
 				DN}
 			} catch (::string const& e) {
 				trace("bad_val",k,v) ;
@@ -177,6 +458,12 @@ void cache_init( bool rescue , bool read_only ) {
 	if (g_cache_config.max_rate        !=ref_config.max_rate        ) sensed_config_str << "max_rate         : "<<g_cache_config.max_rate        <<'\n' ;
 	if (g_cache_config.max_runs_per_job!=ref_config.max_runs_per_job) sensed_config_str << "max_runs_per_job : "<<g_cache_config.max_runs_per_job<<'\n' ;
 	if (g_cache_config.file_sync       !=ref_config.file_sync       ) sensed_config_str << "file_sync        : "<<g_cache_config.file_sync       <<'\n' ;
+	for( TenantConfig const& tc : g_tenants ) {
+		if (!tc.name) continue ;
+		/**/          sensed_config_str << "tenant "<<tc.name<<" : key_prefix="<<tc.key_prefix<<" weight="<<tc.weight ;
+		if (tc.quota) sensed_config_str << " quota="<<tc.quota                                                              ;
+		/**/          sensed_config_str << '\n'                                                                             ;
+	}
 	try {
 		::string sensed_config_file = ADMIN_DIR_S "config" ;
 		unlnk( sensed_config_file                              )                            ; // in case it exists with insufficient perm
@@ -194,11 +481,15 @@ void cache_init( bool rescue , bool read_only ) {
 	{ ::string file=g_store_dir_s+"nodes"     ; sync_guard.access(file) ; _g_nodes_file    .init( file , !read_only ) ; }
 	{ ::string file=g_store_dir_s+"crcs"      ; sync_guard.access(file) ; _g_crcs_file     .init( file , !read_only ) ; }
 	// END_OF_VERSIONING
+	{ ::string file=g_store_dir_s+"tenants"     ; sync_guard.access(file) ; _tenant_init( file , read_only ) ;              }
+	{ ::string file=g_store_dir_s+"stats"       ; sync_guard.access(file) ; _stats_init ( file , read_only ) ;              }
+	{ ::string file=g_store_dir_s+"miss_filter" ; sync_guard.access(file) ; _g_miss_filter_file.init( file , !read_only ) ; }
 	if (rescue) {
 		Fd::Stderr.write(cat("crash detected, check and rescueing cache ",cwd_s(),rm_slash,'\n')) ;
 		CjobData ::s_rescue()                                                                     ;
 		CnodeData::s_rescue()                                                                     ;
 	}
+	if ( !read_only && (rescue||!_g_miss_filter_file) ) _miss_filter_rebuild() ;
 	RateCmp::s_init() ;
 	if (rescue) {
 		cache_chk()                               ;
@@ -217,17 +508,39 @@ void cache_empty_trash() {
 void cache_finalize() {
 	SyncGuard sync_guard { g_file_sync } ;
 	Trace trace("cache_finalize") ;
-	sync_guard.change(g_store_dir_s+"key"      ) ;
-	sync_guard.change(g_store_dir_s+"job_name" ) ;
-	sync_guard.change(g_store_dir_s+"node_name") ;
-	sync_guard.change(g_store_dir_s+"job"      ) ;
-	sync_guard.change(g_store_dir_s+"run"      ) ;
-	sync_guard.change(g_store_dir_s+"node"     ) ;
-	sync_guard.change(g_store_dir_s+"nodes"    ) ;
-	sync_guard.change(g_store_dir_s+"crcs"     ) ;
+	sync_guard.change(g_store_dir_s+"key"        ) ;
+	sync_guard.change(g_store_dir_s+"job_name"   ) ;
+	sync_guard.change(g_store_dir_s+"node_name"  ) ;
+	sync_guard.change(g_store_dir_s+"job"        ) ;
+	sync_guard.change(g_store_dir_s+"run"        ) ;
+	sync_guard.change(g_store_dir_s+"node"       ) ;
+	sync_guard.change(g_store_dir_s+"nodes"      ) ;
+	sync_guard.change(g_store_dir_s+"crcs"       ) ;
+	sync_guard.change(g_store_dir_s+"miss_filter") ;
+	sync_guard.change(g_store_dir_s+"tenants"    ) ;
+	sync_guard.change(g_store_dir_s+"stats"      ) ;
 	trace("done") ;
 }
 
+// lookups are done with g_cache_mutex shared and cannot manipulate lru chains, so accesses are recorded and actually done later
+// recorded runs are guaranteed to be still alive when flushed as any modification of the store flushes them first
+void cache_record_access(Crun run) {
+	Lock lock { _g_accesses_mutex } ;
+	_g_accesses.push_back(run) ;
+}
+
+void cache_flush_accesses() {
+	g_cache_mutex.swear_locked() ;
+	::vector<Crun> accesses ;
+	{	Lock lock { _g_accesses_mutex } ;
+		if (!_g_accesses) return ;
+		::swap(accesses,_g_accesses) ;
+	}
+	Trace trace("cache_flush_accesses",accesses.size()) ;
+	RateCmp::s_refresh() ;
+	for( Crun r : accesses ) r->access() ;
+}
+
 void mk_room( DiskSz sz , Cjob keep_job ) {
 	CrunHdr&  hdr        = CrunData::s_hdr() ;
 	SyncGuard sync_guard { g_file_sync }     ;
@@ -243,8 +556,11 @@ void mk_room( DiskSz sz , Cjob keep_job ) {
 	RateCmp::s_refresh() ;
 	while ( hdr.total_sz && hdr.total_sz+g_reserved_sz+sz>g_cache_config.max_sz ) {
 		SWEAR( +RateCmp::s_tab ) ;                                                  // if total size is non-zero, we must have entries
-		Rate best_rate = *RateCmp::s_tab.begin()                    ;
-		Crun best_run  = RateCmp::s_lrus[best_rate].newer/*oldest*/ ;
+		Crun best_run = _tenant_victim() ;                                          // over-quota tenants first
+		if (!best_run) {
+			Rate best_rate = *RateCmp::s_tab.begin()                    ;
+			/**/ best_run  = RateCmp::s_lrus[best_rate].newer/*oldest*/ ;
+		}
 		//
 		best_run->victimize( best_run->job!=keep_job , &sync_guard ) ;
 	}
@@ -269,6 +585,7 @@ Ckey::Ckey(           ::string const& name ) { self = _g_key_file.search(name)
 Ckey::Ckey( NewType , ::string const& name ) { self = _g_key_file.insert(name).first ; }
 
 void Ckey::victimize() {
+	_g_key_tenants.erase(self) ; // key idx may be reused for another repo key
 	_g_key_file.pop(self) ;
 }
 
@@ -323,7 +640,7 @@ void CompileDigest::operator>>(::string& os) const {              // START_OF_NO
 }                                                                 // END_OF_NO_COV
 
 CompileDigest::~CompileDigest() {
-	for( Cnode& d : deps ) d->dec() ;
+	if (ref_cnted) for( Cnode& d : deps ) d->dec() ;
 }
 
 CompileDigest::CompileDigest( ::vmap<StrId<CnodeIdx>,DepDigest> const& repo_deps , bool for_download , ::vector<CnodeIdx>* dep_ids ) {
@@ -336,6 +653,7 @@ CompileDigest::CompileDigest( ::vmap<StrId<CnodeIdx>,DepDigest> const& repo_deps
 		Crc   crc    ;
 	} ;
 	::vector<Dep> deps_ ;
+	Pdate         start { New } ;
 	Trace trace("compile",repo_deps.size(),STR(for_download),STR(bool(dep_ids))) ;
 	for( auto& [n,dd] : repo_deps ) {
 		bool      is_name = n.is_name()                                              ;
@@ -366,9 +684,7 @@ CompileDigest::CompileDigest( ::vmap<StrId<CnodeIdx>,DepDigest> const& repo_deps
 				case +Accesses(Access::Lnk,Access::Stat) : if ( crc.is_reg()  ) crc =  Crc::Reg               ; break ;
 				case +Accesses(Access::Reg,Access::Stat) : if ( crc.is_lnk()  ) crc =  Crc::Lnk               ; break ;
 			DN}
-		// we lose 1 bit of crc but we must manage errors and it does not desserv an additional field
-		if ( dd.err && a[Access::Err] ) crc = +crc |  CrcErr ;                                            // if not sensed, ignore error status (lmake would stop if not ignored anyway)
-		else                            crc = +crc & ~CrcErr ;
+		crc = _err_crc( crc , dd , a ) ;
 		//
 		deps_.push_back({
 			.bucket = dd.dflags[Dflag::Static] ? 0 : crc!=Crc::None ? 1 : 2
@@ -377,8 +693,10 @@ CompileDigest::CompileDigest( ::vmap<StrId<CnodeIdx>,DepDigest> const& repo_deps
 		}) ;
 	}
 	::sort(deps_) ;
-	for( Dep      & dep : deps_ ) { dep.node->inc() ;          deps    .push_back(dep.node) ; }
+	ref_cnted = !for_download ;
+	for( Dep      & dep : deps_ ) { if (ref_cnted) dep.node->inc() ; deps.push_back(dep.node) ; }
 	for( Dep const& dep : deps_ ) { if (dep.bucket==2) break ; dep_crcs.push_back(dep.crc ) ; }
+	if (_g_stats_file.writable) _stats().compile_digest_time.record(Pdate(New)-start) ;
 	trace("done",dep_ids?dep_ids->size():size_t(0)) ;
 }
 
@@ -464,12 +782,11 @@ void CjobData::operator>>(::string& os) const { // START_OF_NO_COV
 	/**/      os << ')'         ;
 }                                               // END_OF_NO_COV
 
-::pair<Crun,CacheHitInfo> CjobData::match( CompileDigest const& compile_digest ) {
+::pair<Crun,CacheHitInfo> CjobData::match( CompileDigest const& compile_digest ) const {
 	Trace trace("match",idx(),compile_digest) ;
 	CacheHitInfo hit_info = CacheHitInfo::NoJob ;                                           // as long as we have seen no job
 	for( Crun r=lru.older/*newest*/ ; +r ; r = r->job_lru.older ) {
 		hit_info = r->match(compile_digest) ;
-		if (hit_info<=CacheHitInfo::Hit ) { RateCmp::s_refresh() ; r->access()          ; }
 		if (hit_info< CacheHitInfo::Miss) { trace(r,hit_info) ; return { r , hit_info } ; }
 		hit_info = CacheHitInfo::BadDeps ;                                                  // we have seen a job, but it does not match
 	}
@@ -523,6 +840,7 @@ bool/*done*/ CjobData::insert(
 	while (n_runs>=g_cache_config.max_runs_per_job) lru.newer->victimize( false/*victimize_job*/ , sync_guard ) ; // maybe several pass in case.max_runs_per_job has been reduced
 	mk_room( sz , idx() ) ;
 	Crun run { New , key , last , idx() , targets_crc , last_access , sz , rate , compile_digest } ;
+	_miss_filter_record( idx() , compile_digest ) ;
 	trace("miss",run,found_runs,STR(last)) ;
 	if (+reserved_file) rename_run( reserved_file , run->name() , sync_guard ) ;
 	return true/*done*/ ;
@@ -572,7 +890,8 @@ CrunData::CrunData( Ckey k , bool kil , Cjob j , Crc targets_crc_ , Pdate la , D
 	CrunHdr& hdr = s_hdr() ;
 	Trace trace("CrunData",key,STR(key_is_last),job,sz,rate,hdr.total_sz,compile_digest) ;
 	bool first = !RateCmp::s_lrus[rate] ;
-	hdr.total_sz += sz ;
+	hdr.total_sz                   += sz ;
+	_g_tenant_szs[key_tenant(key)] += sz ;
 	//
 	if (first) RateCmp::s_refresh() ;
 	//
@@ -631,7 +950,12 @@ bool/*job_victimized*/ CrunData::victimize( bool victimize_job , SyncGuard* sync
 	if ( victimize_job && last ) { trace("victimize_job",job) ; job->victimize(sync_guard) ; job_victimized = true  ; }
 	//
 	SWEAR( hdr.total_sz >= sz , hdr.total_sz,sz,idx() ) ;
-	hdr.total_sz -= sz ;
+	hdr.total_sz                   -= sz ;
+	_g_tenant_szs[key_tenant(key)] -= sz ;
+	if (_g_stats_file.writable) {
+		_stats().n_victimized  ++    ;
+		_stats().victimized_sz += sz ;
+	}
 	_g_nodes_file.pop(deps    ) ;
 	_g_crcs_file .pop(dep_crcs) ;
 	_g_run_file  .pop(idx()   ) ;
@@ -40,25 +40,92 @@ struct CjobData      ;
 struct CrunData      ;
 struct CnodeData     ;
 
+using Tenant = uint8_t ;
+
+// repo keys are grouped into tenants based on configured prefixes so that a tenant flooding the cache does not evict entries of others
+// tenant 0 gathers repo keys matching no configured tenant
+struct TenantConfig {
+	::string     name       ;
+	::string     key_prefix ;     // repo keys starting with key_prefix belong to this tenant, longest prefix wins
+	Disk::DiskSz quota      = 0 ; // soft quota, 0 means a share of cache size proportional to weight
+	uint32_t     weight     = 1 ;
+} ;
+
+struct TenantStats {
+	Hash::Crc::Val name_crc = 0 ; // used to reset stats when config changes
+	uint64_t       n_hits   = 0 ;
+	uint64_t       n_misses = 0 ;
+} ;
+
+// stats are kept in a mmapped file so they survive server restarts and can be dumped while server is running
+struct LatencyHisto {
+	static constexpr uint8_t NBuckets = 32 ; // bucket i counts durations below 2^i us (and not below 2^(i-1) us), last bucket is unbounded
+	// accesses
+	Time::Delay avg() const ;
+	// services
+	void record(Time::Delay) ;               // can be called concurrently
+	// data
+	uint64_t n       [NBuckets] = {} ;
+	uint64_t total_ns           = 0  ;
+} ;
+
+struct KeyStats {                  // traffic per repo key
+	uint64_t     n_downloads = 0 ;
+	uint64_t     n_hits      = 0 ;
+	uint64_t     n_uploads   = 0 ;
+	Disk::DiskSz uploaded_sz = 0 ;
+} ;
+
+struct CacheStats {
+	static constexpr uint64_t Version = 1 ;               // stats are reset when layout changes, so this must be incremented
+	// data
+	uint64_t     version                      = Version ;
+	uint64_t     n_downloads[N<CacheHitInfo>] = {}      ;
+	LatencyHisto download_time                ;
+	LatencyHisto compile_digest_time          ;
+	uint64_t     n_victimized                 = 0       ;
+	Disk::DiskSz victimized_sz                = 0       ;
+	uint64_t     n_upload_rejects             = 0       ; // uploads refused for lack of room
+} ;
+
 //
 // globals
 //
 
-extern CacheConfig  g_cache_config ;
-extern Disk::DiskSz g_reserved_sz  ;
-extern ::string     g_store_dir_s  ;
-extern FileSync     g_file_sync    ; // file sync to be used by cache_server
+extern CacheConfig                           g_cache_config ;
+extern Disk::DiskSz                          g_reserved_sz  ;
+extern ::string                              g_store_dir_s  ;
+extern FileSync                              g_file_sync    ; // file sync to be used by cache_server
+extern Mutex<MutexLvl::Cache,true/*Shared*/> g_cache_mutex  ; // shared for lookups, exclusive for any modification of the store
+extern ::vector<TenantConfig>                g_tenants      ; // indexed by Tenant
 
 //
 // free functions
 //
 
-void cache_init       ( bool rescue , bool read_only=false ) ;
-void cache_empty_trash(                                    ) ;
-void cache_finalize   (                                    ) ;
-void cache_chk        (                                    ) ;
-void mk_room          ( Disk::DiskSz , Cjob keep_job       ) ;
-void mk_room          ( Disk::DiskSz                       ) ;
+void cache_init          ( bool rescue , bool read_only=false ) ;
+void cache_empty_trash   (                                    ) ;
+void cache_finalize      (                                    ) ;
+void cache_chk           (                                    ) ;
+void cache_record_access ( Crun                               ) ; // can be called with g_cache_mutex shared, actual lru update is deferred ...
+void cache_flush_accesses(                                    ) ; // ... until this is called with g_cache_mutex exclusive
+void mk_room             ( Disk::DiskSz , Cjob keep_job       ) ;
+void mk_room             ( Disk::DiskSz                       ) ;
+
+Tenant             key_tenant            ( Ckey                 ) ;
+Disk::DiskSz       tenant_quota          ( Tenant               ) ;
+Disk::DiskSz       tenant_sz             ( Tenant               ) ;
+TenantStats const& tenant_stats          ( Tenant               ) ;
+void               tenant_record_download( Tenant , CacheHitInfo ) ; // can be called with g_cache_mutex shared
+
+CacheStats const& cache_stats               (                                   ) ;
+KeyStats   const& key_stats                 ( Ckey                              ) ;
+void              stats_new_key             ( Ckey                              ) ; // reset stats as key idx may have been reused
+void              stats_record_download     ( Ckey , CacheHitInfo , Time::Delay ) ; // can be called with g_cache_mutex shared
+void              stats_record_upload       ( Ckey , Disk::DiskSz               ) ;
+void              stats_record_upload_reject(                                   ) ;
+
+bool/*may_hit*/ miss_filter_may_hit( Cjob , ::vmap<Cache::StrId<Cache::CnodeIdx>,DepDigest> const& repo_deps ) ; // can be called with g_cache_mutex shared, false means a sure miss
 
 //
 // structs
@@ -153,6 +220,7 @@ struct CompileDigest {
 	// data
 	VarIdx              n_statics  = 0     ;
 	bool                has_hidden = false ;
+	bool                ref_cnted  = false ; // for download, deps are not ref-counted as they are only accessed with g_cache_mutex shared
 	::vector<Cnode>     deps       ;
 	::vector<Hash::Crc> dep_crcs   ;
 } ;
@@ -206,7 +274,7 @@ struct CjobData {
 	bool     operator+ (         ) const { return +n_runs     ; }
 	::string name      (         ) const { return _name.str() ; }
 	// services
-	::pair<Crun,CacheHitInfo> match( CompileDigest const& ) ;                                    // updates lru related info when hit
+	::pair<Crun,CacheHitInfo> match( CompileDigest const& ) const ;                              // no lru update, caller must record access when hit
 	bool/*done*/ insert(                                                                         // like match, but create when miss
 		CompileDigest const&                                                                     // to search entry
 	,	Ckey key , KeyIsLast key_is_last , Time::Pdate last_access , Disk::DiskSz sz , Rate rate // to create entry
@@ -44,13 +44,59 @@ int main( int argc , char* argv[]) {
 	//
 	Fd::Stdout.write(cat("total_sz : ",CrunData ::s_hdr().total_sz,'\n')) ;
 	//
-	Fd::Stdout.write("\n# id          :  ref_count : name\n") ;
-	for( Ckey k : lst<Ckey>() )
-		Fd::Stdout.write(cat( //!        width right
-			/**/    widen(cat(k         ),13       )
-		,	" : " , widen(cat(k->ref_cnt),10  ,true)
+	Fd::Stdout.write("\n# tenant      :   size  quota occup :       hits     misses rate : key_prefix\n") ;
+	for( Tenant t : iota<Tenant>(g_tenants.size()) ) {
+		TenantConfig const& tc       = g_tenants[t]                  ;
+		TenantStats  const& stats    = tenant_stats(t)               ;
+		uint64_t            n_visits = stats.n_hits + stats.n_misses ;
+		Fd::Stdout.write(cat( //!                                                   width right
+			/**/    widen(+tc.name?tc.name:"<other>"s                                 ,13       )
+		,	" : " , widen(to_short_string_with_unit(tenant_sz   (t))                  , 5  ,true),'B'
+		,	' '   , widen(to_short_string_with_unit(tenant_quota(t))                  , 5  ,true),'B'
+		,	' '   , widen(cat(100*tenant_sz(t)/tenant_quota(t),'%')                   , 5  ,true)
+		,	" : " , widen(cat(stats.n_hits  )                                         ,10  ,true)
+		,	' '   , widen(cat(stats.n_misses)                                         ,10  ,true)
+		,	' '   , widen(n_visits?cat(100*stats.n_hits/n_visits,'%'):"-"s            , 4  ,true)
+		,	" : " ,       tc.key_prefix
+		,'\n')) ;
+	}
+	//
+	CacheStats const& stats = cache_stats() ;
+	Fd::Stdout.write("\n# hit_info       :  downloads\n") ;
+	for( CacheHitInfo hi : iota(All<CacheHitInfo>) )
+		Fd::Stdout.write(cat( //!                            width right
+			/**/    widen(snake_str(hi)                    ,14       )
+		,	" : " , widen(cat(stats.n_downloads[+hi])      ,10  ,true)
+		,'\n')) ;
+	//
+	Fd::Stdout.write("\n# latency        :      count   average : histogram (count per bucket, bucket i is below 2^i us)\n") ;
+	for( auto const& [name,histo] : ::vmap_s<LatencyHisto const*>{ {"download",&stats.download_time} , {"compile_digest",&stats.compile_digest_time} } ) {
+		uint64_t n     = 0 ; for( uint64_t c : histo->n ) n += c ;
+		::string hist  ;     for( uint8_t  i : iota(LatencyHisto::NBuckets) ) if (histo->n[i]) hist << ' '<<i<<':'<<histo->n[i] ;
+		Fd::Stdout.write(cat( //!                            width right
+			/**/    widen(name                             ,14       )
+		,	" : " , widen(cat(n)                           ,10  ,true)
+		,	' '   , widen(cat(histo->avg().usec(),"us")    , 9  ,true)
+		,	" :"  ,       hist
+		,'\n')) ;
+	}
+	//
+	Fd::Stdout.write(cat("\nvictimized     : ",stats.n_victimized," runs, ",to_short_string_with_unit(stats.victimized_sz),"B\n")) ;
+	Fd::Stdout.write(cat(  "upload_rejects : ",stats.n_upload_rejects                                                    ,'\n')) ;
+	//
+	Fd::Stdout.write("\n# id          :  ref_count  downloads       hits    uploads uploaded : name\n") ;
+	for( Ckey k : lst<Ckey>() ) {
+		KeyStats const& ks = key_stats(k) ;
+		Fd::Stdout.write(cat( //!                                        width right
+			/**/    widen(cat(k                                 ),13       )
+		,	" : " , widen(cat(k->ref_cnt                        ),10  ,true)
+		,	' '   , widen(cat(ks.n_downloads                    ),10  ,true)
+		,	' '   , widen(cat(ks.n_hits                         ),10  ,true)
+		,	' '   , widen(cat(ks.n_uploads                      ),10  ,true)
+		,	' '   , widen(to_short_string_with_unit(ks.uploaded_sz), 7  ,true),'B'
 		,	" : " ,           k.str()
 		,'\n')) ;
+	}
 	//
 	Fd::Stdout.write("\n# id          : n_statics n_runs : name\n") ;
 	for( Cjob  j : lst<Cjob>() )
@@ -7,6 +7,7 @@
 
 #include "app.hh"
 #include "process.hh"
+#include "thread.hh"
 
 #include "cache_utils.hh"
 #include "engine.hh"
@@ -14,16 +15,36 @@
 
 using namespace Cache ;
 using namespace Disk  ;
+using namespace Time  ;
 
 struct ConnEntry {
 	Ckey                   key         = {} ;
+	Tenant                 tenant      = 0  ;
 	::uset<CacheUploadKey> upload_keys = {} ;
 } ;
 
+struct DownloadItem {
+	Fd          fd         ;
+	Ckey        key    = {} ;
+	Tenant      tenant = 0  ; // computed by main thread as key_tenant cannot be called from readers
+	CacheRpcReq crr         ;
+} ;
+
 SmallIds<CacheUploadKey> _g_upload_keys  ;
 ::vector<CacheUploadKey> _g_reserved_szs ;
 ::umap<Fd,ConnEntry>     _g_conn_tab     ;
 
+// downloads only need g_cache_mutex shared and are processed by a pool of reader threads while other requests are processed by the main thread
+// main thread must not close a connection while a download is on going as fd could be reused before reply is sent
+static constexpr size_t MaxPendingAccesses = 1000 ; // flush recorded lru accesses at least every that many downloads
+
+ThreadQueue<DownloadItem> _g_download_queue   ;
+Mutex<>                   _g_downloads_mutex  ;
+::condition_variable_any  _g_downloads_cond   ;
+::umap<Fd,size_t>         _g_downloads        ;     // number of on going downloads per connection
+size_t                    _g_n_downloads      = 0 ; // number of downloads since last flush of accesses
+::vector<::jthread>       _g_download_workers ;
+
 static void _release_room(DiskSz sz) {
 	CrunHdr& hdr = CrunData::s_hdr() ;
 	Trace trace("_release_room",sz,hdr.total_sz,g_reserved_sz) ;
@@ -35,24 +56,30 @@ static void _release_room(DiskSz sz) {
 static CacheRpcReply _config( Fd fd , ::string const& repo_key ) {
 	Trace trace("_config",fd,repo_key) ;
 	Ckey key      { New , repo_key }                                           ;
-	bool inserted = _g_conn_tab.try_emplace( fd , ConnEntry{.key=key} ).second ; SWEAR( inserted , fd,repo_key ) ;
+	bool inserted = _g_conn_tab.try_emplace( fd , ConnEntry{.key=key,.tenant=key_tenant(key)} ).second ; SWEAR( inserted , fd,repo_key ) ;
 	// ensure lcache_repair can retrieve repo keys
-	if (!key->ref_cnt) AcFd(cat(PrivateAdminDirS,"repo_keys"),{O_WRONLY|O_APPEND|O_CREAT}).write(cat(+key,' ',repo_key,'\n')) ;
+	if (!key->ref_cnt) {
+		AcFd(cat(PrivateAdminDirS,"repo_keys"),{O_WRONLY|O_APPEND|O_CREAT}).write(cat(+key,' ',repo_key,'\n')) ;
+		stats_new_key(key) ;
+	}
 	//
 	key.inc() ;
 	return { .proc=CacheRpcProc::Config , .config=g_cache_config , .conn_id=uint32_t(fd.fd+1) , .fqdn=fqdn(g_cache_config.domain_name) } ; // conn_id=0 is reserved to mean no id
 }
 
+// called with g_cache_mutex shared, possibly from several threads
 static CacheRpcReply _download(CacheRpcReq const& crr) {
 	Trace trace("_download",crr) ;
 	CacheRpcReply              res    { .proc=CacheRpcProc::Download , .hit_info=CacheHitInfo::NoJob } ;
 	Cjob                       job    = crr.job.is_name() ? Cjob(crr.job.name) : Cjob(crr.job.id)      ; if (!job) { trace("no_job") ; return res ; }
+	if (crr.job.is_name()) res.job_id = +job ;
+	if (!miss_filter_may_hit(job,crr.repo_deps)) { trace("filtered") ; res.hit_info = CacheHitInfo::Miss ; return res ; } // fast path : sure miss, no need to compile deps
 	CompileDigest              deps   { crr.repo_deps , true/*for_download*/ , &res.dep_ids }          ; SWEAR_PROD( deps.n_statics==job->n_statics , crr.job,deps.n_statics,job,job->n_statics ) ;
 	::pair<Crun,CacheHitInfo > digest = job->match(deps)                                               ;
-	if (crr.job.is_name()) res.job_id = +job ;
 	//
 	res.hit_info = digest.second ;
-	if (res.hit_info<CacheHitInfo::Miss) {
+	if (res.hit_info<=CacheHitInfo::Hit ) cache_record_access(digest.first) ;
+	if (res.hit_info< CacheHitInfo::Miss) {
 		res.key         = +digest.first->key         ;
 		res.key_is_last =  digest.first->key_is_last ;
 	}
@@ -60,13 +87,58 @@ static CacheRpcReply _download(CacheRpcReq const& crr) {
 	return res ;
 }
 
+static void _download_thread_func( ::stop_token stop , size_t id ) {
+	t_thread_key = '0'+id ;
+	Trace trace("_download_thread_func",id) ;
+	for(;;) {
+		::optional<DownloadItem> item = _g_download_queue.pop(stop) ; if (!item) break ;
+		Fd                       fd   = item->fd                      ;
+		CacheRpcReply            crr  ;
+		{	SharedLock lock  { g_cache_mutex } ;
+			Pdate      start { New           } ;
+			crr = _download(item->crr) ;
+			tenant_record_download( item->tenant , crr.hit_info                    ) ;
+			stats_record_download ( item->key    , crr.hit_info , Pdate(New)-start ) ;
+		}
+		try                       { OMsgBuf(crr).send( fd , {} ) ; }
+		catch (::string const& e) { trace("no_reply",fd,e) ;       } // client is dead, it will be noticed by main thread
+		Lock lock { _g_downloads_mutex } ;
+		auto it = _g_downloads.find(fd) ; SWEAR( it!=_g_downloads.end() , fd ) ;
+		if (!--it->second) { _g_downloads.erase(it) ; _g_downloads_cond.notify_all() ; }
+	}
+	trace("done") ;
+}
+
+static void _push_download( Fd fd , CacheRpcReq&& crr ) {
+	if (++_g_n_downloads>=MaxPendingAccesses) {           // ensure lru stays reasonably up to date under heavy download load
+		Lock lock { g_cache_mutex } ;
+		cache_flush_accesses() ;
+		_g_n_downloads = 0 ;
+	}
+	{	Lock lock { _g_downloads_mutex } ;
+		_g_downloads[fd]++ ;
+	}
+	auto         it   = _g_conn_tab.find(fd)               ;
+	DownloadItem item { .fd=fd , .crr=::move(crr) } ;
+	if (it!=_g_conn_tab.end()) {
+		item.key    = it->second.key    ;
+		item.tenant = it->second.tenant ;
+	}
+	_g_download_queue.push(::move(item)) ;
+}
+
+static void _wait_downloads(Fd fd) {
+	Lock lock { _g_downloads_mutex } ;
+	_g_downloads_cond.wait( lock , [&]{ return !_g_downloads.contains(fd) ; } ) ;
+}
+
 static CacheRpcReply _upload( Fd fd , DiskSz reserved_sz ) {
 	Trace trace("_upload",fd,reserved_sz) ;
 	auto it = _g_conn_tab.find(fd) ;
 	if (it==_g_conn_tab.end()) { trace("conn_not_found") ; return { .proc=CacheRpcProc::Upload , .msg="cache is diabled" } ; }
 	//
 	try                       { mk_room(reserved_sz) ;                                              }
-	catch (::string const& e) { trace("throw",e) ; return { .proc=CacheRpcProc::Upload , .msg=e } ; } // no upload possible
+	catch (::string const& e) { trace("throw",e) ; stats_record_upload_reject() ; return { .proc=CacheRpcProc::Upload , .msg=e } ; } // no upload possible
 	//
 	CacheUploadKey upload_key = _g_upload_keys.acquire() ;
 	it->second.upload_keys.insert(upload_key) ;
@@ -96,6 +168,7 @@ static void _commit( Fd fd , CacheRpcReq const& crr ) {
 	,	crr.force , crr.targets_crc
 	,	reserved_file(crr.upload_key) , &::ref(SyncGuard(g_file_sync))
 	) ;
+	if (inserted) stats_record_upload( conn_entry.key , sz ) ;
 	trace("done",STR(inserted)) ;
 }
 
@@ -115,32 +188,41 @@ struct CacheServer : AutoServer<CacheServer> {
 	using RpcReq   = CacheRpcReq   ;
 	using RpcReply = CacheRpcReply ;
 	using Item     = RpcReq        ;
-	static constexpr uint64_t Magic = CacheMagic ;                                                             // AutoServer expects Magic definition
+	static constexpr uint64_t Magic = CacheMagic ;                                                           // AutoServer expects Magic definition
 	// cxtors & casts
 	using AutoServer<CacheServer>::AutoServer ;
 	// injection
-	void end_connection(Fd fd) {
+	Bool3/*done*/ process_item( Fd fd , RpcReq&& crr ) {
+		Trace trace("process_item",fd,crr) ;
+		Fd conn_fd = crr.conn_id ? Fd(crr.conn_id-1) : fd ;                                                  // get fd from conn_id when coming from job_exec
+		switch (crr.proc) {
+			case Proc::Download : _push_download( fd , ::move(crr) ) ; return No ;                           // from lmake_server, processed by readers
+			case Proc::None     : _wait_downloads(fd)                ; break     ;                           // fd is about to be closed, ensure no reply will be sent to it
+		DN}
+		Lock lock { g_cache_mutex } ;                                                                        // all other requests modify the store
+		cache_flush_accesses() ;                                                                             // ensure recorded runs are still alive when flushed
+		switch (crr.proc) { //!                                                         key
+			case Proc::None    :                                                                 break     ;
+			case Proc::Config  : OMsgBuf( _config (conn_fd,crr.repo_key   ) ).send( fd , {} ) ; return No ;  // from lmake_server
+			case Proc::Upload  : OMsgBuf( _upload (conn_fd,crr.reserved_sz) ).send( fd , {} ) ; break     ;  // from job_exec
+			case Proc::Commit  :          _commit (conn_fd,crr            )                   ; return No ;  // from lmake_server
+			case Proc::Dismiss :          _dismiss(conn_fd,crr.upload_key )                   ; return No ;  // .
+		DF}                                                                                                  // NO_COV
+		_end_connection(fd) ;
+		return Yes ;
+	}
+private :
+	// end_connection is called with internal lock held, so store cannot be locked from there
+	void _end_connection(Fd fd) {
 		if (n_connections()==1) cache_empty_trash() ;
 		//
 		auto       it         = _g_conn_tab.find(fd) ; if (it==_g_conn_tab.end()) return ;
 		ConnEntry& conn_entry = it->second           ;
 		//
-		for( CacheUploadKey upload_key : mk_vector(conn_entry.upload_keys) ) _dismiss( fd , upload_key ) ;     // copy upload_keys as _dismiss erases entries in it
+		for( CacheUploadKey upload_key : mk_vector(conn_entry.upload_keys) ) _dismiss( fd , upload_key ) ;   // copy upload_keys as _dismiss erases entries in it
 		conn_entry.key.dec() ;
 		_g_conn_tab.erase(it) ;
 	}
-	Bool3/*done*/ process_item( Fd fd , RpcReq&& crr ) {
-		Trace trace("process_item",fd,crr) ;
-		Fd conn_fd = crr.conn_id ? Fd(crr.conn_id-1) : fd ;                                                    // get fd from conn_id when coming from job_exec
-		switch (crr.proc) { //!                                                           key           done
-			case Proc::None     :                                                                 return Yes ;
-			case Proc::Config   : OMsgBuf( _config  (conn_fd,crr.repo_key   ) ).send( fd , {} ) ; return No  ; // from lmake_server
-			case Proc::Download : OMsgBuf( _download(        crr            ) ).send( fd , {} ) ; return No  ; // from lmake_server
-			case Proc::Upload   : OMsgBuf( _upload  (conn_fd,crr.reserved_sz) ).send( fd , {} ) ; return Yes ; // from job_exec
-			case Proc::Commit   :          _commit  (conn_fd,crr            )                   ; return No  ; // from lmake_server
-			case Proc::Dismiss  :          _dismiss (conn_fd,crr.upload_key )                   ; return No  ; // .
-		DF}                                                                                                    // NO_COV
-	}
 } ;
 
 int main( int argc , char** argv ) {
@@ -185,7 +267,16 @@ int main( int argc , char** argv ) {
 	mk_dir_empty_s(cat(AdminDirS,"reserved/")) ;
 	//
 	cache_init(server.rescue) ;
+	//
+	size_t n_readers = ::max( ::thread::hardware_concurrency() , 1u ) ;
+	trace("n_readers",n_readers) ;
+	for( size_t id : iota(n_readers) ) _g_download_workers.emplace_back( _download_thread_func , 1+id ) ;
+	//
 	bool interrupted = server.event_loop() ;
+	_g_download_workers.clear() ;                                                       // stop readers before finalizing store
+	{	Lock lock { g_cache_mutex } ;
+		cache_flush_accesses() ;
+	}
 	cache_finalize() ;
 	//
 	trace("done",STR(interrupted),New) ;
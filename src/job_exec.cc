@@ -3,6 +3,8 @@
 // This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
 // This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
 
+#include <sys/statvfs.h> // statvfs
+
 #include "app.hh"
 #include "disk.hh"
 #include "fd.hh"
@@ -31,14 +33,24 @@ KeyedService              g_service_end     ;
 KeyedService              g_service_mngt    ;
 KeyedService              g_service_start   ;
 JobStartRpcReply          g_start_info      ;
+AcFd                      g_start_ack_fd    ;                // if start info is provided at launch time, server acknowledges start on this connection
+bool                      g_start_ok        = true         ;
 ::vector<UserTraceEntry>* g_user_trace      = nullptr      ;
 
-JobStartRpcReply get_start_info() {
+// if start_fd is provided, start info may have been provided at launch time, in which case we just report start to server without waiting for its reply
+JobStartRpcReply get_start_info(Fd start_fd) {
 	Bool3            found_server = No                                  ;  // for trace only
 	KeyedService     service      = g_gather.server_master_fd.service() ;
 	JobStartRpcReply res          ;
 	::string         fqdn_        ;
-	Trace trace("get_start_info",g_service_start,service) ;
+	Trace trace("get_start_info",g_service_start,service,start_fd) ;
+	// if start info cannot be read from start_fd, ask server as usual, then dont keep server pipe
+	if (+start_fd) {
+		try                       { res = IMsgBuf().receive<JobStartRpcReply>( start_fd , Yes/*once*/ , {}/*key*/ ) ; }
+		catch (::string const& e) { trace("no_direct_start_info",e) ;                                                 }
+		try                       { ::dup2( AcFd("/dev/null") , start_fd ) ;                                          }
+		catch (::string const& e) { exit(Rc::System,e) ;                                                              }
+	}
 	try {
 		ClientSockFd fd { g_service_start } ;
 		g_service_mngt.addr = g_service_end.addr = fd.addr(true/*peer*/) ; // server address is only passed to g_service_start
@@ -47,20 +59,35 @@ JobStartRpcReply get_start_info() {
 		found_server = Maybe ; /**/  OMsgBuf( JobStartRpcReq({g_seq_id,g_job},service) ).send(fd) ;
 		//                           ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 		fqdn_ = fqdn(g_domain_name) ;                                      // call fqdn() in parallel to server connection
-		//                         vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-		found_server = Yes ; res = IMsgBuf().receive<JobStartRpcReply>( fd , No/*once*/ , {}/*key*/ ) ; // read without limit as there is a single message
-		//                         ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+		if (+res) {
+			g_start_ack_fd = ::move(fd) ;                                  // acknowledge is waited for as late as possible, just before running job
+		} else {
+			//                         vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+			found_server = Yes ; res = IMsgBuf().receive<JobStartRpcReply>( fd , No/*once*/ , {}/*key*/ ) ; // read without limit as there is a single message
+			//                         ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+		}
 	} catch (::string const& e) {
 		trace("no_start_info",STR(found_server),e) ;
-		if (+e) exit(Rc::Fail,"while connecting to server : ",e             ) ;                         // this may be a server config problem, better to report if verbose
-		else    exit(Rc::Fail,"cannot connect to server at ",g_service_start) ;                         // .
+		if (+e) exit(Rc::Fail,"while connecting to server : ",e             ) ;                             // this may be a server config problem, better to report if verbose
+		else    exit(Rc::Fail,"cannot connect to server at ",g_service_start) ;                             // .
 	}
-	res.autodep_env.fqdn = ::move(fqdn_) ;                                                              // call fqdn() before potential chroot in g_start_info.enter()
+	res.autodep_env.fqdn = ::move(fqdn_) ;                                                                  // call fqdn() before potential chroot in g_start_info.enter()
 	g_user_trace->emplace_back( New/*date*/ , Comment::StartInfo , CommentExt::Reply ) ;
 	trace(res) ;
 	return res ;
 }
 
+// if false, server does not want us any more, as if we had received no start info (eof means false)
+bool/*ok*/ wait_start_ack() {
+	if (!g_start_ack_fd) return g_start_ok ; // start info was not provided at launch time or ack already received
+	Trace trace("wait_start_ack") ;
+	try                       { g_start_ok = IMsgBuf().receive<bool>( g_start_ack_fd , No/*once*/ , {}/*key*/ ) ; }
+	catch (::string const& e) { trace("no_ack",e) ; g_start_ok = false ;                                          }
+	g_start_ack_fd.close() ;
+	trace("done",STR(g_start_ok)) ;
+	return g_start_ok ;
+}
+
 ::string g_to_unlnk ;                                                                   // XXX/ : suppress when CentOS7 bug is fixed
 ::vector_s cmd_line(::string const& repo_root_s) {
 	static const size_t ArgMax = ::sysconf(_SC_ARG_MAX) ;
@@ -165,6 +192,22 @@ static void _compute_crc_thread_func( size_t id , ::vector<NodeIdx> const* crcs
 	return msg ;
 }
 
+// upload only needs targets as established by analysis, so it is done while crcs are computed
+// targets are copied as their digests are updated by compute_crcs
+static void _upload_thread_func( Delay exe_time , ::vmap_s<TargetDigest> targets , ::vector<FileInfo> const* target_fis , CacheRemoteSide::UploadDigest* /*out*/ ud , ::string* /*out*/ msg ) {
+	t_thread_key = 'U' ;
+	Trace trace("_upload_thread_func",targets.size()) ;
+	try { //!   vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+		*ud = g_start_info.cache.upload( exe_time , targets , *target_fis , g_start_info.zlvl ) ;
+		//    ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+		g_gather.drain_heartbeat() ;                                                                     // regularly drain hardbeat
+		trace("done",ud->upload_key) ;
+	} catch (::string const& e) {
+		trace("throw",e) ;
+		*msg = e ;
+	}
+}
+
 Crc mk_targets_crc(::vmap_s<TargetDigest> const& targets) {
 	::map_s<::pair<Crc,Tflags>> crc_src ;
 	for( auto const& [tn,td] : targets ) {
@@ -175,14 +218,185 @@ Crc mk_targets_crc(::vmap_s<TargetDigest> const& targets) {
 	return Crc( New , serialize(crc_src) ) ;
 }
 
+// cgroup v2 in which job is run when configured : accounting captures all processes, including those escaping the process tree, and declared resources are enforced
+// all operations are best effort : if cgroup cannot be setup, job runs as if not configured
+struct JobCgroup {
+	static constexpr size_t CpuPeriod = 100'000 ; // in us, cpu.max period
+	static constexpr Delay  RmTick    { 0.010 } ; // delay between attempts to remove cgroup
+	// accesses
+	bool operator+() const { return +dir_s ; }
+	// services
+	void open ( ::string const& base_s , size_t mem , uint32_t cpu ) ;
+	void stats( JobStats&/*inout*/ , ::string&/*inout*/ msg        ) const ;
+	void close( bool kill                                          ) ;
+private :
+	size_t _val( const char* file , ::string const& key={} ) const ; // value associated with key in flat keyed file, or file content if no key, 0 if not found
+	// data
+public :
+	::string dir_s ;
+	AcFd     procs ;                                                 // child moves itself into cgroup by writing into it
+	size_t   mem   = 0 ;
+} ;
+
+void JobCgroup::open( ::string const& base_s , size_t mem_ , uint32_t cpu ) {
+	Trace trace("JobCgroup::open",base_s,mem_,cpu) ;
+	auto set = [&]( ::string const& file , ::string const& val )->bool {
+		try                       { AcFd(file,{.flags=O_WRONLY}).write(val) ; return true  ; }
+		catch (::string const& e) { trace("cannot_set",file,val,e) ;           return false ; }
+	} ;
+	for( const char* c : {"+cpu","+io","+memory"} ) set( base_s+"cgroup.subtree_control" , c ) ; // controllers may already be enabled or not delegated to us
+	::string dir_s_ = cat(base_s,"lmake-",::getpid(),'/') ;                                          // pid is unique among running jobs on this host
+	::rmdir(no_slash(dir_s_).c_str()) ;                                                              // in case a previous job with same pid left it behind
+	if (::mkdir(no_slash(dir_s_).c_str(),0755)!=0) { trace("cannot_mkdir",dir_s_,::strerror(errno)) ; return ; }
+	dir_s = ::move(dir_s_) ;
+	mem   = mem_           ;
+	if (mem) {
+		set( dir_s+"memory.max"       , cat(mem) ) ;
+		set( dir_s+"memory.swap.max"  , "0"      ) ;                                                // else job would swap rather than be killed
+		set( dir_s+"memory.oom.group" , "1"      ) ;                                                // kill job as a whole rather than a random process
+	}
+	if (cpu) set( dir_s+"cpu.max" , cat(cpu*CpuPeriod,' ',CpuPeriod) ) ;
+	try                       { procs = AcFd(dir_s+"cgroup.procs",{.flags=O_WRONLY}) ;   }
+	catch (::string const& e) { trace("no_procs",e) ; close(false/*kill*/) ; return ; }
+	trace("done",dir_s) ;
+}
+
+size_t JobCgroup::_val( const char* file , ::string const& key ) const {
+	::string txt ;
+	try                     { txt = AcFd(dir_s+file).read() ; }
+	catch (::string const&) { return 0 ;                      } // controller not available
+	::vector_s toks = split(txt) ;
+	try {
+		if (!key) return +toks ? from_string<size_t>(toks[0]) : 0 ;
+		for( size_t i=0 ; i+1<toks.size() ; i+=2 ) if (toks[i]==key) return from_string<size_t>(toks[i+1]) ;
+	} catch (::string const&) {}                                // e.g. max
+	return 0 ;
+}
+
+// measures from rusage are kept if larger as they do not depend on which controllers are available
+void JobCgroup::stats( JobStats& stats , ::string& msg ) const {
+	if (!self) return ;
+	Delay cpu { double(_val("cpu.stat","usage_usec"))/1'000'000 } ;
+	stats.mem = ::max( stats.mem , _val("memory.peak") ) ;
+	if (Delay(stats.cpu)<cpu) stats.cpu = cpu ;
+	try {
+		size_t io_read  = 0 ;
+		size_t io_write = 0 ;
+		for( ::string const& t : split(AcFd(dir_s+"io.stat").read()) ) {                  // format is : <maj>:<min> rbytes=<n> wbytes=<n> ... for each device
+			if      (t.starts_with("rbytes=")) io_read  += from_string<size_t>(t.substr(7)) ;
+			else if (t.starts_with("wbytes=")) io_write += from_string<size_t>(t.substr(7)) ;
+		}
+		stats.io_read  = ::max( stats.io_read  , io_read  ) ;
+		stats.io_write = ::max( stats.io_write , io_write ) ;
+	} catch (::string const&) {}                                                           // io controller not available
+	if (_val("memory.events","oom_kill")) msg << "killed as it used more memory than its mem resource ("<<to_short_string_with_unit(mem)<<"B)\n" ;
+}
+
+void JobCgroup::close(bool kill) {
+	if (!self) return ;
+	Trace trace("JobCgroup::close",dir_s,STR(kill)) ;
+	procs.close() ;
+	if (kill) try { AcFd(dir_s+"cgroup.kill",{.flags=O_WRONLY}).write("1") ; } catch (::string const&) {} // cgroup.kill is not available before Linux 5.14
+	for( int i=0 ;; i++ ) {                                                                                 // killed processes take a little while to leave cgroup
+		if ( ::rmdir(no_slash(dir_s).c_str())==0 || errno!=EBUSY || i>=10 ) break ;                        // if daemons are left running, cgroup is left behind
+		RmTick.sleep_for() ;
+	}
+	dir_s = {} ;
+}
+
+// per-host relay : forward messages from all jobs running on this host to server over a single connection
+// it is launched by the first job that cannot reach it and exits when server closes connection, no trace as it is shared between jobs
+// stdout is closed when ready so that launching job can wait for it
+int relay_main(KeyedService const& relay) {
+	auto [addr,len] = relay_sock_addr(relay)                                                 ;
+	AcFd master_fd  = ::socket( AF_UNIX , SOCK_STREAM|SOCK_CLOEXEC|SOCK_NONBLOCK , 0 ) ;
+	if (::bind( master_fd , reinterpret_cast<::sockaddr const*>(&addr) , len )!=0) return 0 ; // another relay is already running for this server
+	if (::listen( master_fd , JobExecBacklog )!=0                                ) return 1 ;
+	ClientSockFd server_fd ;
+	try                     { server_fd = ClientSockFd(relay) ; }
+	catch (::string const&) { return 1 ;                        }
+	block_sigs({SIGPIPE}) ;                                                                   // generate errors rather than being killed when a job dies
+	::dup2( AcFd("/dev/null") , Fd::Stdout ) ;                                                // signal we are ready
+	//
+	::umap<Fd,IMsgBuf> slaves ;
+	Epoll<>            epoll  { New } ;
+	epoll.add_read(master_fd) ;
+	epoll.add_read(server_fd) ;                                                               // server sends nothing, this is to detect connection closure
+	for(;;)
+		for( Epoll<>::Event const& event : epoll.wait() ) {
+			Fd fd = event.fd() ;
+			if (fd==server_fd) return 0 ;
+			if (fd==master_fd) {
+				Fd slave_fd = ::accept4( master_fd , nullptr/*addr*/ , nullptr/*addrlen*/ , SOCK_CLOEXEC|SOCK_NONBLOCK ) ;
+				if (!slave_fd) continue ;
+				epoll.add_read(slave_fd) ;
+				slaves.try_emplace(slave_fd) ;
+				continue ;
+			}
+			::optional<JobRelayRpcReq> jrrr ;
+			try                     { jrrr = slaves.at(fd).receive_step<JobRelayRpcReq>( fd , Yes/*fetch*/ , {}/*key*/ ) ; }
+			catch (::string const&) { jrrr = JobRelayRpcReq() ;                                                            }     // malformed, close connection
+			if (!jrrr) continue ;                                                                                                  // message is partial
+			if (+*jrrr) {
+				//    vvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+				try { OMsgBuf(*jrrr).send(server_fd) ; } catch (::string const&) { return 1 ; }                                     // key is only sent with first message
+				//    ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+				try                     { fd.write("\n") ; }                                                                       // acknowledge, content is meaningless
+				catch (::string const&) {                  }                                                                       // job is gone, message is forwarded nevertheless
+			}
+			slaves.erase(fd) ;
+			epoll.close( false/*write*/ , fd ) ;
+		}
+}
+
+// launch per-host relay if it is not running, jobs connect directly to server until it is ready
+void start_relay(KeyedService const& relay) {
+	if (+relay_connect(relay)) return ;
+	AcPipe ready { New , O_CLOEXEC } ;
+	pid_t  pid   = ::fork()          ;
+	if (pid==0) {                                                                                                              // double fork to detach relay from job
+		::setsid() ;
+		if (::fork()==0) {
+			::dup2( AcFd("/dev/null") , Fd::Stdin  ) ;
+			::dup2( ready.write       , Fd::Stdout ) ;
+			::dup2( AcFd("/dev/null") , Fd::Stderr ) ;
+			::string    relay_str = relay.str()                                                 ;
+			const char* args[]    = { "/proc/self/exe" , "--relay" , relay_str.c_str() , nullptr } ;
+			::execv( args[0] , const_cast<char* const*>(args) ) ;
+		}
+		::_exit(0) ;
+	}
+	ready.write.close() ;
+	if (pid>0) ::waitpid( pid , nullptr/*wstatus*/ , 0/*options*/ ) ;
+	ready.read.read() ;                                                                                                        // wait for relay to be ready (or dead)
+}
+
 int main( int argc , char* argv[] ) {
-	Pdate    start_overhead { New }        ;
-	SeqId    trace_id       = 0/*garbage*/ ;
-	::string chroot_tag     ;
-	uint64_t upload_key     = 0            ; // key used to identify temporary data uploaded to the cache
-	Crc      targets_crc    ;
+	if ( argc==3 && ::string_view(argv[1])=="--relay" ) return relay_main(KeyedService(argv[2])) ;
+	::vector_s      warm_args ;
+	::vector<char*> warm_argv ;
+	if ( argc==2 && ::string_view(argv[1])=="-" ) {                                        // warm mode : we have been launched in advance and actual args are received on stdin when job is launched
+		warm_args = IMsgBuf().receive<::vector_s>( Fd::Stdin , Yes/*once*/ , {}/*key*/ ) ;
+		if (!warm_args) return 0 ;                                                         // server closed our stdin, it does not need us any more
+		::string stderr_file = ::move(warm_args.back()) ; warm_args.pop_back() ;
+		try {
+			if (+stderr_file       ) ::dup2( AcFd(stderr_file,{O_WRONLY|O_TRUNC|O_CREAT}) , Fd::Stderr ) ;
+			if (warm_args.size()<=8) ::dup2( AcFd("/dev/null"                          ) , Fd::Stdin  ) ;  // dont keep server pipe, unless start info is read from it
+		} catch (::string const& e) { exit(Rc::System,e) ; }                                               // NO_COV defensive programming
+		/**/                             warm_argv.push_back(argv[0] ) ;
+		for( ::string& a : warm_args   ) warm_argv.push_back(a.data()) ;
+		argc = warm_argv.size() ;
+		argv = warm_argv.data() ;
+	}
+	Pdate     start_overhead { New }        ;
+	SeqId     trace_id       = 0/*garbage*/ ;
+	::string  chroot_tag     ;
+	uint64_t  upload_key     = 0            ; // key used to identify temporary data uploaded to the cache
+	Crc       targets_crc    ;
+	Fd        start_fd       ;                // if provided, start info is first read from there
+	JobCgroup cgroup         ;                // if configured, job is run in its own cgroup
 	//
-	swear_prod(argc==9,argc) ;               // syntax is : job_exec server:port/*start*/ server:port/*mngt*/ server:port/*end*/ domain_name repo_root seq_id job_idx trace_file
+	swear_prod(argc==9||argc==10,argc) ;      // syntax is : job_exec server:port/*start*/ server:port/*mngt*/ server:port/*end*/ domain_name repo_root seq_id job_idx trace_file [start_fd]
 	//
 	try { g_service_start   = {                   argv[1],true/*name_ok*/} ; } catch (::string const& e) { exit(Rc::Fail,"cannot connect to server : ",e) ; }
 	/**/  g_service_mngt    = {                   argv[2]                } ;
@@ -192,6 +406,7 @@ int main( int argc , char* argv[] ) {
 	/**/  g_seq_id          = from_string<SeqId >(argv[6])                 ;
 	/**/  g_job             = from_string<JobIdx>(argv[7])                 ;
 	/**/  trace_id          = from_string<SeqId >(argv[8])                 ;
+	if (argc>9) start_fd    = from_string<int   >(argv[9])                 ;
 	//
 	JobEndRpcReq end_report { {g_seq_id,g_job} } ;
 	end_report.digest   = { .status=Status::EarlyError } ;                   // prepare to return an error, so we can goto End anytime
@@ -203,7 +418,7 @@ int main( int argc , char* argv[] ) {
 	g_gather.server_master_fd = { 0/*backlog*/ } ;                           // server socket must be listening before connecting to server and last to the very end to ensure we can handle heartbeats
 	//
 	if (::chdir(g_phy_repo_root_s.c_str())!=0) {                                                                                         // START_OF_NO_COV defensive programming
-		g_start_info = get_start_info() ; if (!g_start_info) return 0 ;                                                                  // if !g_start_info, server ask us to give up
+		g_start_info = get_start_info(start_fd) ; if (!g_start_info) return 0 ;                                                          // if !g_start_info, server ask us to give up
 		end_report.msg_stderr.msg << "cannot chdir to root : "<<g_phy_repo_root_s<<rm_slash ;
 		goto End ;
 	}                                                                                                                                    // END_OF_NO_COV
@@ -216,7 +431,7 @@ int main( int argc , char* argv[] ) {
 		trace("pid",::getpid(),::getpgrp()) ;
 		trace("start_overhead",start_overhead) ;
 		//
-		g_start_info = get_start_info() ; if (!g_start_info) return 0 ;                                                                  // if !g_start_info, server ask us to give up
+		g_start_info = get_start_info(start_fd) ; if (!g_start_info) return 0 ;                                                          // if !g_start_info, server ask us to give up
 		try                       { g_start_info.mk_canon( g_phy_repo_root_s ) ;                                              }
 		catch (::string const& e) { end_report.msg_stderr.msg += e ; goto End ;                                               }          // NO_COV defensive programming
 		try                       { g_start_info.autodep_env.file_sync = auto_file_sync(g_start_info.autodep_env.file_sync) ; }
@@ -267,6 +482,7 @@ int main( int argc , char* argv[] ) {
 			if ( size_t pos=chroot_tag.find('.') ; pos!=Npos ) chroot_tag.resize(pos) ;
 			else                                               rm_slash(chroot_tag)   ;
 		}
+		if (+g_start_info.cgroup_s) cgroup.open( g_start_info.cgroup_s , g_start_info.cgroup_mem , g_start_info.cgroup_cpu ) ; // before entering namespaces as cgroup fs may not be visible afterwards
 		try {
 			g_start_info.enter(
 				/*out*/  enter_accesses
@@ -302,6 +518,7 @@ int main( int argc , char* argv[] ) {
 		::map_ss cmd_env = mk_map(g_start_info.env) ;
 		g_gather.as_session    =        true                            ;
 		g_gather.autodep_env   = ::move(g_start_info.autodep_env      ) ;
+		g_gather.cgroup_procs  =        cgroup.procs                    ;
 		g_gather.ddate_prec    =        g_start_info.ddate_prec         ;
 		g_gather.env           =        &cmd_env                        ;
 		g_gather.job           =        g_job                           ;
@@ -314,8 +531,14 @@ int main( int argc , char* argv[] ) {
 		g_gather.rule          =        g_start_info.rule               ;
 		g_gather.seq_id        =        g_seq_id                        ;
 		g_gather.service_mngt  =        g_service_mngt                  ;
+		if (+g_start_info.relay) {
+			g_start_info.relay.addr = g_service_mngt.addr ;                                       // server provides a service to be completed with its addr as seen by us
+			g_gather.service_relay  = g_start_info.relay  ;
+			start_relay(g_start_info.relay) ;
+		}
 		g_gather.timeout       =        g_start_info.timeout            ;
 		g_gather.user_trace    =        g_user_trace                    ;
+		g_gather.watch_deps    =        g_start_info.watch_deps         ;
 		//
 		if (!g_start_info.method)                                                                 // if no autodep, consider all static deps are fully accessed as we have no precise report
 			for( auto& [d,dd_edf] : g_start_info.deps ) if (dd_edf.first.dflags[Dflag::Static]) {
@@ -356,6 +579,7 @@ int main( int argc , char* argv[] ) {
 			g_gather.child_stdout.no_std() ;
 		}
 		g_gather.cmd_line = cmd_line(repo_root_s) ;
+		if (!wait_start_ack()) goto End ;                                                                                           // server must have recorded start before job runs
 		Status status ;
 		try { //!    vvvvvvvvvvvvvvvvvvvvv
 			status = g_gather.exec_child() ;
@@ -374,31 +598,37 @@ int main( int argc , char* argv[] ) {
 		//                      ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 		trace("analysis",g_gather.start_date,g_gather.end_date,status,g_gather.msg,digest.msg) ;
 		//
-		Delay exe_time = g_gather.end_date - g_gather.start_date ;
-		//                 vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-		::string crc_msg = compute_crcs( digest , /*out*/end_report.total_sz ) ;
-		//                 ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
-		if ( status==Status::Ok && +crc_msg ) { status = Status::Forbidden ; do_upload = false ; }
-		end_report.msg_stderr.msg <<add_nl<< ::move(crc_msg) ;
-		//
+		Delay                         exe_time   = g_gather.end_date - g_gather.start_date ;
+		CacheRemoteSide::UploadDigest ud         = {}                                      ;
+		::string                      upload_msg ;
+		::jthread                     uploader   ;
 		if (do_upload) {                                                                                                            // jobs in error are not cached
 			trace("cache_addr",g_start_info.cache.service.addr) ;
 			if (!g_start_info.cache.service.addr) {
 				end_report.cache_addr = g_start_info.cache.service.addr = SockFd::s_addr(g_start_info.cache.fqdn,true/*name_ok*/) ; // if solving cache addr, report to server so next jobs can reuse it
 				trace("cache_fqdn",g_start_info.cache.fqdn,g_start_info.cache.service.addr) ;
 			}
-			try { //!                              vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-				CacheRemoteSide::UploadDigest ud = g_start_info.cache.upload( exe_time , digest.targets , digest.target_fis , g_start_info.zlvl ) ;
-				//                                 ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
-				g_gather.drain_heartbeat() ;                                                                                        // regularly drain hardbeat
+			uploader = ::jthread( _upload_thread_func , exe_time , digest.targets , &digest.target_fis , /*out*/&ud , /*out*/&upload_msg ) ;
+		}
+		//                 vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+		::string crc_msg = compute_crcs( digest , /*out*/end_report.total_sz ) ;
+		//                 ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+		if (uploader.joinable()) uploader.join() ;
+		if ( status==Status::Ok && +crc_msg ) { status = Status::Forbidden ; do_upload = false ; }
+		end_report.msg_stderr.msg <<add_nl<< ::move(crc_msg) ;
+		//
+		if (+ud.upload_key) {
+			if (do_upload) {
 				upload_key            = ud.upload_key                  ;
 				targets_crc           = mk_targets_crc(digest.targets) ;
 				end_report.total_z_sz = ud.z_sz                        ;
 				trace("cache",upload_key) ;
-			} catch (::string const& e) {
-				trace("cache_upload_throw",e) ;
-				end_report.msg_stderr.msg <<"cannot upload to cache : "<<e<<'\n' ;
+			} else {
+				g_start_info.cache.dismiss( ud.upload_key , g_start_info.cache.conn_id ) ;                                          // crcs could not be computed, job will not be cached
 			}
+		}
+		if (do_upload) {
+			if (+upload_msg) end_report.msg_stderr.msg <<"cannot upload to cache : "<<upload_msg<<'\n' ;
 			CommentExts ces ; if (!upload_key) ces |= CommentExt::Err ;
 			g_user_trace->emplace_back( New/*date*/ , Comment::UploadedToCache , ces , cat(g_start_info.zlvl) ) ;
 		}
@@ -413,10 +643,20 @@ int main( int argc , char* argv[] ) {
 		/**/                        end_report.msg_stderr.msg += g_gather.msg ;
 		if (status!=Status::Killed) end_report.msg_stderr.msg += digest  .msg ;
 		JobStats stats {
-			.mem = size_t(rsrcs.ru_maxrss<<10)
-		,	.cpu = Delay(rsrcs.ru_utime) + Delay(rsrcs.ru_stime)
-		,	.job = exe_time
+			.mem      = size_t(rsrcs.ru_maxrss<<10)
+		,	.cpu      = Delay(rsrcs.ru_utime) + Delay(rsrcs.ru_stime)
+		,	.job      = exe_time
+		,	.io_read  = size_t(rsrcs.ru_inblock)<<9                     // in 512 bytes blocks
+		,	.io_write = size_t(rsrcs.ru_oublock)<<9                     // .
 		} ;
+		cgroup.stats( /*inout*/stats , /*inout*/end_report.msg_stderr.msg ) ;
+		if (g_start_info.tmp_sz) {                                                                                                  // tmp dir is a tmpfs, measure its usage before it vanishes
+			struct ::statvfs tmp_vfs ;
+			if (::statvfs(g_gather.autodep_env.tmp_dir_s.c_str(),&tmp_vfs)==0) {
+				stats.tmp = size_t(tmp_vfs.f_blocks-tmp_vfs.f_bfree) * tmp_vfs.f_frsize ;
+				if (!tmp_vfs.f_bavail) end_report.msg_stderr.msg << "tmp dir is full (tmp resource is "<<to_short_string_with_unit(g_start_info.tmp_sz)<<"B)\n" ;
+			}
+		}
 		end_report.digest = {
 			.upload_key     =           upload_key
 		,	.targets        = ::move   (digest.targets       )
@@ -433,23 +673,29 @@ int main( int argc , char* argv[] ) {
 		end_report.wstatus           =        g_gather.wstatus   ;
 	}
 End :
-	{	Trace trace("end",end_report.digest) ;
+	if (wait_start_ack()) {                                                                                                           // else server does not want us any more
+		Trace trace("end",end_report.digest) ;
 		end_report.digest.chroot_tag     = chroot_tag             ;
 		end_report.digest.has_msg_stderr = +end_report.msg_stderr ;
 		try {
-			ClientSockFd fd           { g_service_end } ;
-			Pdate        end_overhead { New           } ;
+			Pdate end_overhead { New } ;
 			g_user_trace->emplace_back( end_overhead , Comment::EndOverhead , CommentExts() , snake_str(end_report.digest.status) ) ;
 			end_report.digest.exe_time = end_overhead - start_overhead ;                                                              // measure overhead as late as possible
-			//vvvvvvvvvvvvvvvvvvvvvvvvvv
-			OMsgBuf(end_report).send(fd) ;
-			//^^^^^^^^^^^^^^^^^^^^^^^^^^
-			trace("done",end_overhead) ;
+			if ( +g_start_info.relay && send_to_relay(g_start_info.relay,true/*is_end*/,serialize(end_report)) ) {
+				trace("done_relay",end_overhead) ;
+			} else {
+				ClientSockFd fd { g_service_end } ;
+				//vvvvvvvvvvvvvvvvvvvvvvvvvv
+				OMsgBuf(end_report).send(fd) ;
+				//^^^^^^^^^^^^^^^^^^^^^^^^^^
+				trace("done",end_overhead) ;
+			}
 		} catch (::string const& e) {
 			if (+upload_key) g_start_info.cache.dismiss( upload_key , g_start_info.cache.conn_id ) ;                                  // suppress temporary data if server cannot handle them
 			exit(Rc::Fail,"after job execution : ",e) ;
 		}
 	}
+	cgroup.close(g_start_info.kill_daemons) ;
 	try                       { g_start_info.exit() ;                             }
 	catch (::string const& e) { exit(Rc::Fail,"cannot cleanup namespaces : ",e) ; }                                                   // NO_COV defensive programming
 	//
@@ -69,8 +69,10 @@ void print_start(JobStartRpcReply const& jsrr) {
 	g_out << "sub_repo_s       : "<<jsrr.autodep_env.sub_repo_s     <<'\n' ;
 	g_out << "timeout          : "<<jsrr.timeout                    <<'\n' ;
 	g_out << "tmp_dir_s        : "<<jsrr.autodep_env.tmp_dir_s      <<'\n' ; // tmp directory on disk
+	g_out << "tmp_sz           : "<<jsrr.tmp_sz                     <<'\n' ;
 	g_out << "tmp_view_s       : "<<jsrr.job_space.tmp_view_s       <<'\n' ;
 	g_out << "use_script       : "<<jsrr.use_script                 <<'\n' ;
+	g_out << "watch_deps       : "<<jsrr.watch_deps                 <<'\n' ;
 	//
 	g_out << "cmd :\n"            ; g_out << indent(jsrr.cmd)<<add_nl  ;
 	g_out << "deps :\n"           ; _print_map  (jsrr.deps           ) ;
@@ -90,6 +92,9 @@ void print_end(JobEndRpcReq const& jerr) {
 	g_out << "stats.cpu         : "<<jerr.stats.cpu      <<'\n' ;
 	g_out << "stats.job         : "<<jerr.stats.job      <<'\n' ;
 	g_out << "stats.mem         : "<<jerr.stats.mem      <<'\n' ;
+	g_out << "stats.io_read     : "<<jerr.stats.io_read  <<'\n' ;
+	g_out << "stats.io_write    : "<<jerr.stats.io_write <<'\n' ;
+	g_out << "stats.tmp         : "<<jerr.stats.tmp      <<'\n' ;
 	//
 	g_out << "digest.status     : "<<jerr.digest.status  <<'\n' ;
 	g_out << "digest.exe_time   : "<<jerr.digest.exe_time<<'\n' ;
@@ -31,6 +31,7 @@ namespace Backends {
 		TraceLock                  lock { Backend::_s_mutex , BeChnl , "send_reply" } ;
 		auto                       it   = Backend::_s_start_tab.find(job)             ; if (it==Backend::_s_start_tab.end()) return ; // job is dead without waiting for reply, curious but possible
 		Backend::StartEntry const& e    = it->second                                  ; if (jmrr.seq_id!=e.conn.seq_id     ) return ; // .
+		if (jmrr.proc==JobMngtProc::DepDirect) Backend::s_tab[+e.tag]->resume(job) ;                                                 // re-acquire resources before job resumes
 		try {
 			OMsgBuf(jmrr).send(ClientSockFd(e.conn.service)) ;
 		} catch (::string const&) {                            // if we cannot connect to job, assume it is dead while we processed the request
@@ -167,6 +168,17 @@ namespace Backends {
 	// Backend
 	//
 
+	struct Backend::StartCtx {                           // info computed from start request and needed to record start
+		JobInfoStart               jis                 ;
+		Tag                        tag                 = {}    ;
+		StartSteps                 steps               ;
+		bool                       deps_done           = false ;
+		::vmap<Node,FileActionTag> pre_action_warnings ;
+		MsgStderr                  start_msg_err       ;
+		uint16_t                   max_stderr_len      = 0     ;
+		Delay                      start_delay         ;
+	} ;
+
 	StaticUniqPtr<Backend>                Backend::s_tab[N<Tag>]                    ;
 	in_addr_t                             Backend::s_server_addr                    = 0 ;
 	Mutex<MutexLvl::Backend >             Backend::_s_mutex                         ;
@@ -177,11 +189,13 @@ namespace Backends {
 	Backend::JobStartThread               Backend::_s_job_start_thread              ;
 	Backend::JobMngtThread                Backend::_s_job_mngt_thread               ;
 	Backend::JobEndThread                 Backend::_s_job_end_thread                ;
+	Backend::JobRelayThread               Backend::_s_job_relay_thread              ;
 	::jthread                             Backend::_s_heartbeat_thread              ;
 	SmallIds<SmallId,true/*ThreadSafe*/>  Backend::_s_small_ids                     ;
 	Mutex<MutexLvl::StartJob>             Backend::_s_starting_job_mutex            ;
 	Atomic<JobIdx>                        Backend::_s_starting_job                  ;
 	::map<Job,Backend::StartEntry>        Backend::_s_start_tab                     ;
+	::umap<Job,Backend::StartCtx>         Backend::_s_direct_starts                 ;
 	Backend::Workload                     Backend::_s_workload                      ;
 	::map <Pdate,JobExec>                 Backend::_s_deferred_report_queue_by_date ;
 	::umap<Job  ,Pdate  >                 Backend::_s_deferred_report_queue_by_job  ;
@@ -275,6 +289,21 @@ namespace Backends {
 		}
 	}
 
+	void Backend::s_suspend(Job job) {
+		Trace trace(BeChnl,"s_suspend",job) ;
+		StartEntry::Conn conn ;
+		int              sig  = 0 ;
+		{	TraceLock   lock  { _s_mutex , BeChnl , "s_suspend" } ;
+			auto        it    = _s_start_tab.find(+job)            ; if (it==_s_start_tab.end()) return ; // job is dead, nothing to suspend
+			StartEntry& entry = it->second                         ;
+			sig  = s_tab[+entry.tag]->suspend(job) ; if (!sig) return ;
+			conn = entry.conn                      ;
+		}
+		trace("sig",sig) ;
+		try                       { OMsgBuf( JobMngtRpcReply{.proc=JobMngtProc::Suspend,.seq_id=conn.seq_id,.sig=sig} ).send( ClientSockFd(conn.service) ) ; }
+		catch (::string const& e) { trace("no_job",e) ;                                                                                                   } // if job is dead, heartbeat will notice
+	}
+
 	void Backend::_s_handle_deferred_report(::stop_token stop) {
 		Pdate now { New } ;
 		Trace trace("_s_handle_deferred_report",now) ;
@@ -306,46 +335,58 @@ namespace Backends {
 			bool erased = _s_deferred_report_queue_by_date.erase(jit->second) ; SWEAR(erased,it->first) ;
 			/**/          _s_deferred_report_queue_by_job .erase(jit        ) ;
 		}
+		if ( auto dit=_s_direct_starts.find(it->first) ; dit!=_s_direct_starts.end() ) { // start info was provided to job_exec, but it never reported
+			_s_small_ids.release(dit->second.jis.start.small_id) ;
+			_s_direct_starts.erase(dit) ;
+		}
 		_s_start_tab.erase(it) ;
 	}
 
-	void Backend::_s_handle_job_start( JobStartRpcReq&& jsrr , Fd fd ) {
-		if (!jsrr) return ;                                                 // if connection is lost, ignore it
-		jsrr.service.addr = SockFd::s_addr(fd,true/*peer*/) ;               // job_exec does not know its own address, but we do
+	// if direct, start info is computed at launch time, before job_exec runs, and there is no fd
+	bool/*ok*/ Backend::_s_prepare_start( StartCtx& ctx/*out*/ , JobStartRpcReq&& jsrr , Fd fd , bool direct ) {
+		Trace trace(BeChnl,"_s_prepare_start",jsrr,STR(direct)) ;
+		SeqId                       seq_id              = jsrr.seq_id             ;
+		Tag&                        tag                 = ctx.tag                 ;
+		Job                         job                 { jsrr.job }              ;
+		RuleData const&             rd                  = *job->rule()            ;
+		::vector<ReqIdx>            reqs                ;
+		JobInfoStart&               jis                 = ctx.jis                 ;
+		JobStartRpcReply&           reply               = jis.start               ;
+		::string        &           cmd                 = reply.cmd               ;
+		SubmitInfo      &           submit_info         = jis.submit_info         ;
+		::vmap_ss       &           rsrcs               = jis.rsrcs               ;
+		::vmap<Node,FileActionTag>& pre_action_warnings = ctx.pre_action_warnings ;
+		MsgStderr&                  start_msg_err       = ctx.start_msg_err       ;
+		StartSteps&                 steps               = ctx.steps               ;
 		//
-		Trace trace(BeChnl,"_s_handle_job_start",jsrr) ;
-		SWEAR( +fd , jsrr ) ;                                               // fd is needed to reply
-		SeqId             seq_id      = jsrr.seq_id                 ;
-		Tag               tag         = {}                          ;
-		Job               job         { jsrr.job }                  ;
-		RuleData const&   rd          = *job->rule()                ;
-		::vector<ReqIdx>  reqs        ;
-		JobInfoStart      jis         { .rule_crc_cmd=rd.crc->cmd } ;
-		JobStartRpcReply& reply       = jis.start                   ;
-		::string        & cmd         = reply.cmd                   ;
-		SubmitInfo      & submit_info = jis.submit_info             ;
-		::vmap_ss       & rsrcs       = jis.rsrcs                   ;
+		jis.rule_crc_cmd = rd.crc->cmd ;
 		//
 		// to lock for minimal time, we lock twice
 		// 1st time, we only gather info, real decisions will be taken when we lock the 2nd time
 		// because the only thing that can happend between the 2 locks is that entry disappears, we can move info from entry during 1st lock
 		{	TraceLock lock { _s_mutex , BeChnl , "_s_handle_job_start1" } ; // prevent sub-backend from manipulating _s_start_tab from main thread, lock for minimal time
 			//
-			auto        it    = _s_start_tab.find(+job) ; if (it==_s_start_tab.end()   ) { trace("not_in_tab1" ,job                         ) ; return ; }
-			StartEntry& entry = it->second              ; if (entry.conn.seq_id!=seq_id) { trace("bad_seq_id1" ,job,entry.conn.seq_id,seq_id) ; return ; }
+			auto        it    = _s_start_tab.find(+job) ; if (it==_s_start_tab.end()   ) { trace("not_in_tab1" ,job                         ) ; return false ; }
+			StartEntry& entry = it->second              ; if (entry.conn.seq_id!=seq_id) { trace("bad_seq_id1" ,job,entry.conn.seq_id,seq_id) ; return false ; }
 			//
 			if (entry.started!=No) {
+				if (direct) { trace("already_started",job,entry.started) ; return false ; }
 				Lock lock{Req::s_reqs_mutex} ;                                                                                      // taking Req::s_reqs_mutex is compulsory to derefence req
 				for( Req r : entry.reqs ) r->audit_job( Color::Warning , "double_start" , job , SockFd::s_addr(fd,true/*peer*/) ) ;
 				trace("double_start",job,entry.conn.seq_id,seq_id) ;
-				return ;
+				return false ;
+			}
+			entry.started = Maybe     ;
+			tag           = entry.tag ;
+			if (direct) {                                                                                                           // entry must stay intact in case start info cannot be provided
+				submit_info = entry.submit_info ;
+				rsrcs       = entry.rsrcs       ;
+			} else {
+				submit_info = ::move(entry.submit_info) ;
+				rsrcs       = ::move(entry.rsrcs      ) ;
 			}
-			entry.started                 = Maybe                     ;
-			tag                           =        entry.tag          ;
-			submit_info                   = ::move(entry.submit_info) ;
-			rsrcs                         = ::move(entry.rsrcs      ) ;
-			reqs                          =        entry.reqs         ;
-			::tie(jis.eta,reply.keep_tmp) =        entry.req_info()   ;
+			reqs                          = entry.reqs       ;
+			::tie(jis.eta,reply.keep_tmp) = entry.req_info() ;
 		}
 		// set server address at which it can be contacted by jobs
 		// first job is given fqdn, then then the address as soon as it is known
@@ -353,15 +394,12 @@ namespace Backends {
 		//
 		trace("submit_info",submit_info) ;
 		::vmap<Node,FileAction>    pre_actions           ;
-		::vmap<Node,FileActionTag> pre_action_warnings   ;
 		StartCmdAttrs              start_cmd_attrs       ;
 		StartRsrcsAttrs            start_rsrcs_attrs     ;
 		StartAncillaryAttrs        start_ancillary_attrs ;
-		MsgStderr                  start_msg_err         ;
 		Rule::RuleMatch            match                 = job->rule_match()              ;
 		::vmap_s<DepDigest>&       deps                  = submit_info.deps               ;                                         // these are the deps for dynamic attriute evaluation
 		size_t                     n_chked_deps          = deps.size()                    ;
-		StartSteps                 steps                 ;
 		::vmap_s<DepSpec>          dep_specs             = rd.deps_attrs.dep_specs(match) ;                                         // this cannot fail as it was already run to construct job
 		//
 		bool no_incremental ;
@@ -489,8 +527,23 @@ namespace Backends {
 		/**/                            reply.network_delay              = g_config->network_delay                                           ;
 		/**/                            reply.nice                       = submit_info.nice!=uint8_t(-1) ? submit_info.nice : g_config->nice ;
 		/**/                            reply.rule                       = rd.user_name()                                                    ;
+		/**/                            reply.watch_deps                 = g_config->watch_deps                                              ;
 		if (rd.stdin_idx !=Rule::NoVar) reply.stdin                      = dep_specs           [rd.stdin_idx ].second.txt                    ;
 		if (rd.stdout_idx!=Rule::NoVar) reply.stdout                     = reply.static_matches[rd.stdout_idx].first                         ;
+		if ( g_config->job_relay && tag!=Tag::Local ) reply.relay = _s_job_relay_thread.fd.service(0/*addr*/) ;                              // job_exec provides server addr as it sees it
+		if (+g_config->cgroup_s) {
+			reply.cgroup_s = g_config->cgroup_s ;
+			for( auto const& [k,v] : rsrcs )                                                                                        // enforce declared resources
+				try {
+					if      (k=="mem") reply.cgroup_mem = from_string_with_unit<'M'>(v)<<20 ;                                       // mem is expressed in MB by default, as in backends
+					else if (k=="cpu") reply.cgroup_cpu = from_string<uint32_t>(v)          ;
+				} catch (::string const&) {}                                                                                        // ignore non-numeric resources
+		}
+		if (g_config->tmp_fs)
+			for( auto const& [k,v] : rsrcs )
+				if (k=="tmp")
+					try                     { reply.tmp_sz = from_string_with_unit<'M'>(v)<<20 ; }                                  // tmp is expressed in MB by default, as in backends
+					catch (::string const&) {                                                    }                                  // ignore non-numeric resources
 		//
 		/**/                 reply.deps                 = _mk_digest_deps(::move(dep_specs  )) ;
 		/**/                 jis.stems                  =                 ::move(match.stems)  ;
@@ -503,7 +556,7 @@ namespace Backends {
 				if ( auto it=dep_idxes.find(dn) ; it!=dep_idxes.end() )                                       reply.deps[it->second].second.first |= dd ;              // update existing dep
 				else                                                    { dep_idxes[dn] = reply.deps.size() ; reply.deps.emplace_back(dn,::pair(dd,ExtraDflags())) ; } // create new dep
 		}
-		bool deps_done =                                                             // true if all deps are done for at least one non-zombie req
+		ctx.deps_done = // true if all deps are done for at least one non-zombie req
 			::any_of(
 				reqs
 			,	[&](Req r) {
@@ -521,23 +574,48 @@ namespace Backends {
 				}
 			)
 		;
+		ctx.max_stderr_len = start_ancillary_attrs.max_stderr_len ;
+		ctx.start_delay    = start_ancillary_attrs.start_delay    ;
+		return true ;
+	}
+
+	// if direct, reply has already been provided to job_exec together with its small_id and we just acknowledge the start
+	void Backend::_s_record_start( StartCtx&& ctx , Fd fd , bool direct ) {
+		JobInfoStart&               jis                 = ctx.jis                 ;
+		JobStartRpcReply&           reply               = jis.start               ;
+		SubmitInfo      &           submit_info         = jis.submit_info         ;
+		::vmap_s<DepDigest>&        deps                = submit_info.deps        ;
+		::vmap<Node,FileActionTag>& pre_action_warnings = ctx.pre_action_warnings ;
+		MsgStderr&                  start_msg_err       = ctx.start_msg_err       ;
+		StartSteps                  steps               = ctx.steps               ;
+		bool                        deps_done           = ctx.deps_done           ;
+		Tag                         tag                 = ctx.tag                 ;
+		SeqId                       seq_id              = jis.pre_start.seq_id    ;
+		Job                         job                 { jis.pre_start.job }     ;
+		auto                        release_small_id    = [&]() { if (direct) _s_small_ids.release(reply.small_id) ; } ; // if we give up, small_id provided to job_exec is not used
+		Trace trace(BeChnl,"_s_record_start",job,seq_id,STR(direct)) ;
+		//
 		_s_starting_job = +job ; fence() ;                                           // used to ensure _s_handle_job_start is done for this job when _s_handle_job_end is called
 		{	Lock    lock     { _s_starting_job_mutex } ;                             // .
 			JobExec job_exec ;
 			//
 			{	TraceLock lock { _s_mutex , BeChnl , "_s_handle_job_start2" } ;      // prevent sub-backend from manipulating _s_start_tab from main thread, lock for minimal time
 				//
-				auto        it    = _s_start_tab.find(+job) ; if (it==_s_start_tab.end()   ) { trace("not_in_tab2" ,job                               ) ; return ; }
-				StartEntry& entry = it->second              ; if (entry.conn.seq_id!=seq_id) { trace("bad seq_id2" ,job,entry.conn.seq_id,seq_id      ) ; return ; }
+				auto        it    = _s_start_tab.find(+job) ; if (it==_s_start_tab.end()   ) { trace("not_in_tab2" ,job                               ) ; release_small_id() ; return ; }
+				StartEntry& entry = it->second              ; if (entry.conn.seq_id!=seq_id) { trace("bad seq_id2" ,job,entry.conn.seq_id,seq_id      ) ; release_small_id() ; return ; }
 				//
-				entry.max_stderr_len = start_ancillary_attrs.max_stderr_len ;
+				entry.max_stderr_len = ctx.max_stderr_len ;
 				//
-				if ( ::all_of( entry.reqs , [](Req r) { return r.zombie() ; } ) ) return ;
+				if ( ::all_of( entry.reqs , [](Req r) { return r.zombie() ; } ) ) {  // if direct, job_exec sees eof instead of acknowledge and gives up
+					release_small_id() ;
+					return ;
+				}
 				//
 				SWEAR( entry.started==Maybe , job,entry.started,entry.start_date ) ; // ensure we do not overwrite an already started entry
 				//                           vvvvvvvvvvvvvvvvv
 				jis.pre_start.msg << add_nl<<s_start(tag,+job) ;
 				//                           ^^^^^^^^^^^^^^^^^
+				jis.placement = s_placement(tag,+job) ;
 				if ( +~steps || !deps_done ) {
 					Status status = Status::EarlyError ;
 					if (!deps_done) {
@@ -569,14 +647,17 @@ namespace Backends {
 					g_engine_queue.emplace( Proc::End   , ::move(job_exec) , ::move(jd)                                        ) ;
 					//^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 					trace("release_start_tab",entry,steps) ;
+					release_small_id() ;
 					_s_start_tab_erase(it) ;
 					return ;
 				}
 				//
-				reply.small_id = _s_small_ids.acquire() ;
-				//    vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-				try { OMsgBuf(reply).send( fd , {}/*key*/ ) ; } catch (::string const&) {}                           // send reply ASAP to minimize overhead, failure will be caught by heartbeat
-				//    ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+				if (!direct) {
+					reply.small_id = _s_small_ids.acquire() ;
+					//    vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+					try { OMsgBuf(reply).send( fd , {}/*key*/ ) ; } catch (::string const&) {}                       // send reply ASAP to minimize overhead, failure will be caught by heartbeat
+					//    ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+				}
 				job_exec = { job , jis.pre_start.service.addr , New/*start*/ , {}/*end*/ } ;                         // job starts
 				//
 				entry.started       = Yes                               ;
@@ -585,12 +666,14 @@ namespace Backends {
 				entry.conn.service  = jis.pre_start.service             ;
 				entry.conn.small_id = reply.small_id                    ;
 			}
+			if (direct)
+				try { OMsgBuf(true).send( fd , {}/*key*/ ) ; } catch (::string const&) {}                            // acknowledge start once recorded, failure will be caught by heartbeat
 			MsgStderr msg_stderr ;
 			bool      report_now =                                                                                   // dont defer long jobs or if a message is to be delivered to user
 					+pre_action_warnings
 				||	+start_msg_err
 				||	is_retry(submit_info.reason.tag)                                                                 // emit retry start message
-				||	Delay(job->exe_time())>=start_ancillary_attrs.start_delay                                        // if job is probably long, emit start message immediately
+				||	Delay(job->exe_time())>=ctx.start_delay                                                          // if job is probably long, emit start message immediately
 			;
 			if (+start_msg_err) msg_stderr = { cat(jis.pre_start.msg,add_nl,start_msg_err.msg) , ::move(start_msg_err.stderr) } ;                      // get msg befor jis is moved
 			reply.deps = {} ;                                                                                                                          // deps official info is in JobDigest
@@ -601,7 +684,7 @@ namespace Backends {
 			g_engine_queue.emplace( Proc::Start , ::copy(job_exec) , report_now , ::move(pre_action_warnings) , ::move(msg_stderr) ) ;
 			//^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 			if (!report_now) {
-				Pdate report_date = Pdate(New) + start_ancillary_attrs.start_delay ;                                                                   // record before moving job_exec
+				Pdate report_date = Pdate(New) + ctx.start_delay ;                                                                                     // record before moving job_exec
 				{	TraceLock lock     { _s_mutex , BeChnl , "s_handle_job_start3" }                                           ;                       // allow queues manipulation
 					bool      inserted = _s_deferred_report_queue_by_date.try_emplace( report_date , ::move(job_exec) ).second ; SWEAR(inserted,job) ;
 					/**/      inserted = _s_deferred_report_queue_by_job .try_emplace( job         , report_date      ).second ; SWEAR(inserted,job) ;
@@ -612,6 +695,60 @@ namespace Backends {
 		fence() ; _s_starting_job = 0 ; // for perf : avoid taking _s_starting_job_mutex in _s_handle_job_* to check _s_handle_job_start is done
 	}
 
+	void Backend::_s_handle_job_start( JobStartRpcReq&& jsrr , Fd fd ) {
+		if (!jsrr) return ;                                              // if connection is lost, ignore it
+		jsrr.service.addr = SockFd::s_addr(fd,true/*peer*/) ;            // job_exec does not know its own address, but we do
+		//
+		Trace trace(BeChnl,"_s_handle_job_start",jsrr) ;
+		SWEAR( +fd , jsrr ) ;                                            // fd is needed to reply
+		StartCtx ctx    ;
+		bool     direct = false ;
+		{	TraceLock lock { _s_mutex , BeChnl , "_s_handle_job_start" } ;
+			if ( auto it=_s_direct_starts.find(jsrr.job) ; it!=_s_direct_starts.end() && it->second.jis.pre_start.seq_id==jsrr.seq_id ) {
+				ctx    = ::move(it->second) ;
+				direct = true               ;
+				_s_direct_starts.erase(it) ;
+			}
+		}
+		if (direct) {
+			ctx.jis.pre_start.service = jsrr.service ;                   // job_exec reports its start after having received start info at launch time
+		} else {
+			if (!_s_prepare_start( ctx , ::move(jsrr) , fd , false/*direct*/ )) return ;
+		}
+		_s_record_start( ::move(ctx) , fd , direct ) ;
+	}
+
+	::string Backend::_s_direct_start(Job job) {
+		Trace trace(BeChnl,"_s_direct_start",job) ;
+		SeqId seq_id ;
+		{	TraceLock lock { _s_mutex , BeChnl , "_s_direct_start1" } ;
+			auto it = _s_start_tab.find(job) ; if (it==_s_start_tab.end()) return {} ;
+			seq_id = it->second.conn.seq_id ;
+		}
+		StartCtx ctx ;
+		if (!_s_prepare_start( ctx , JobStartRpcReq({seq_id,+job},{}/*service*/) , {}/*fd*/ , true/*direct*/ )) return {} ;
+		trace("prepared",seq_id,ctx.steps,STR(ctx.deps_done)) ;
+		TraceLock lock { _s_mutex , BeChnl , "_s_direct_start2" } ;
+		auto it = _s_start_tab.find(job) ; if ( it==_s_start_tab.end() || it->second.conn.seq_id!=seq_id ) return {} ;
+		if ( +~ctx.steps || !ctx.deps_done ) { // errors must be reported by the classic path when job_exec asks for its start info
+			it->second.started = No ;
+			return {} ;
+		}
+		ctx.jis.start.small_id = _s_small_ids.acquire() ;
+		::string res = serialize(ctx.jis.start) ;
+		_s_direct_starts.try_emplace( job , ::move(ctx) ) ;
+		return res ;
+	}
+
+	void Backend::_s_cancel_direct_start(Job job) {
+		Trace trace(BeChnl,"_s_cancel_direct_start",job) ;
+		TraceLock lock { _s_mutex , BeChnl , "_s_cancel_direct_start" } ;
+		auto dit = _s_direct_starts.find(job) ; if (dit==_s_direct_starts.end()) return ;
+		_s_small_ids.release(dit->second.jis.start.small_id) ;
+		_s_direct_starts.erase(dit) ;
+		if ( auto it=_s_start_tab.find(job) ; it!=_s_start_tab.end() ) it->second.started = No ; // job_exec will ask for its start info
+	}
+
 	void Backend::_s_handle_job_mngt( JobMngtRpcReq&& jmrr , Fd fd ) {
 		switch (jmrr.proc) {
 			case JobMngtProc::None       :                                 // if connection is lost, ignore it
@@ -660,6 +797,11 @@ namespace Backends {
 		trace("done") ;
 	}
 
+	void Backend::_s_handle_job_relay( JobRelayRpcReq&& jrrr , Fd fd ) {
+		if (jrrr.is_end) _s_handle_job_end ( ::move(jrrr.end ) , fd ) ;
+		else             _s_handle_job_mngt( ::move(jrrr.mngt) , fd ) ;
+	}
+
 	void Backend::_s_handle_job_end( JobEndRpcReq&& jerr , Fd ) {
 		if (!jerr) return ;                                               // if connection is lost, ignore it
 		JobDigest<>& digest = jerr.digest ;
@@ -688,6 +830,7 @@ namespace Backends {
 			je.cache_idx1     = entry.submit_info.cache_idx1                                             ;
 			je.tokens1        = entry.submit_info.tokens1                                                ;
 			je.max_stderr_len = entry.max_stderr_len                                                     ;
+			je.stats          = jerr.stats                                                               ;
 			//
 			trace("release_start_tab",job,entry) ;
 			// if we have no fd, job end was invented by heartbeat, no acknowledge
@@ -801,7 +944,7 @@ namespace Backends {
 				status = lost_report.second==HeartbeatState::Err ? Status::EarlyLostErr : Status::EarlyLost ;
 				//
 				trace("handle_job",job,entry,status) ;
-				_s_start_tab.erase(it) ;
+				_s_start_tab_erase(it) ;
 			}
 			{	JobExec      je   { job , New          } ;                                                                          // job starts and ends, no host
 				JobEndRpcReq jerr { {0/*seq_id*/,+job} } ;
@@ -861,12 +1004,14 @@ namespace Backends {
 			_s_job_start_thread      .open( 'S' , _s_handle_job_start       , JobExecBacklog ) ; s_record_thread('S',_s_job_start_thread      .thread) ;
 			_s_job_mngt_thread       .open( 'M' , _s_handle_job_mngt        , JobExecBacklog ) ; s_record_thread('M',_s_job_mngt_thread       .thread) ;
 			_s_job_end_thread        .open( 'E' , _s_handle_job_end         , JobExecBacklog ) ; s_record_thread('E',_s_job_end_thread        .thread) ;
+			_s_job_relay_thread      .open( 'Y' , _s_handle_job_relay       , JobExecBacklog ) ; s_record_thread('Y',_s_job_relay_thread      .thread) ;
 			_s_deferred_report_thread.open( 'R' , _s_handle_deferred_report                  ) ; s_record_thread('R',_s_deferred_report_thread.thread) ;
 			_s_deferred_wakeup_thread.open( 'W' , _s_handle_deferred_wakeup                  ) ; s_record_thread('W',_s_deferred_wakeup_thread.thread) ;
 			//
 			_s_job_start_thread.wait_started() ;
 			_s_job_mngt_thread .wait_started() ;
 			_s_job_end_thread  .wait_started() ;
+			_s_job_relay_thread.wait_started() ;
 			//
 			_s_job_exec = *g_lmake_root_s+"_bin/job_exec" ;
 		}
@@ -128,6 +128,7 @@ namespace Backends {
 			using JobStartThread = ServerThread    <JobStartRpcReq,false/*Flush*/> ;
 			using JobMngtThread  = ServerThread    <JobMngtRpcReq ,false/*Flush*/> ;
 			using JobEndThread   = ServerThread    <JobEndRpcReq  ,false/*Flush*/> ;
+			using JobRelayThread = ServerThread    <JobRelayRpcReq,false/*Flush*/,true/*Persistent*/> ;
 			using DeferredThread = TimedQueueThread<DeferredEntry ,false/*Flush*/> ;
 			// statics
 			static bool            s_ready     (Tag) ;
@@ -153,26 +154,36 @@ namespace Backends {
 			static Pdate s_submitted_eta(Req r) { return _s_workload.submitted_eta(r) ; }
 			// called by job_exec thread
 			static ::string/*msg*/          s_start            ( Tag , Job             ) ;                       // called by job_exec  thread, sub-backend lock must have been takend by caller
+			static ::string                 s_placement        ( Tag , Job             ) ;                       // .
 			static ::pair_s<bool/*retry*/>  s_end              ( Tag , Job    , Status ) ;                       // .
 			static ::vector<Job>            s_kill_waiting_jobs( Tag , Req={}          ) ;                       // kill all waiting jobs for this req (all if 0), return killed jobs
 			static void                     s_kill_job         ( Tag , Job             ) ;                       // job must be spawned
 			static void                     s_heartbeat        ( Tag                   ) ;                       // called by heartbeat thread, sub-backend lock must have been takend by caller
 			static ::pair_s<HeartbeatState> s_heartbeat        ( Tag , Job             ) ;                       // called by heartbeat thread, sub-backend lock must have been takend by caller
+			static void                     s_suspend          ( Job                   ) ;                       // called by engine thread when job waits for direct deps, resumed when reply is sent
 			//
 		protected :
 			static void s_register( Tag t , Backend& be ) {
 				s_tab[+t] = &be ;
 			}
+			// direct start : start info is computed at launch time and provided to job_exec, which then only reports its start
+			// _s_direct_start returns serialized start info (empty if job_exec must ask for it), _s_cancel_direct_start is called if it cannot be provided
+			static ::string/*start_info*/ _s_direct_start       (Job) ;
+			static void                   _s_cancel_direct_start(Job) ;
 		private :
+			struct StartCtx ;
 			static void _s_kill_req              ( Req={}                                                    ) ; // kill all if req==0
 			static void _s_wakeup_remote         ( Job , StartEntry::Conn const& , Pdate start , JobMngtProc ) ;
 			static void _s_heartbeat_thread_func ( ::stop_token                                              ) ;
 			static void _s_handle_job_start      ( JobStartRpcReq&& , Fd={}                                  ) ;
 			static void _s_handle_job_mngt       ( JobMngtRpcReq && , Fd={}                                  ) ;
 			static void _s_handle_job_end        ( JobEndRpcReq  && , Fd={}                                  ) ;
+			static void _s_handle_job_relay      ( JobRelayRpcReq&& , Fd={}                                  ) ;
 			static void _s_handle_deferred_report( ::stop_token                                              ) ;
 			static void _s_handle_deferred_wakeup( DeferredEntry&&                                           ) ;
 			static void _s_start_tab_erase       ( ::map<Job,StartEntry>::iterator                           ) ;
+			static bool _s_prepare_start         ( StartCtx&/*out*/ , JobStartRpcReq&& , Fd , bool direct    ) ; // return false if start must be ignored
+			static void _s_record_start          ( StartCtx&&       , Fd               , bool direct         ) ;
 			// static data
 		public :
 			static StaticUniqPtr<Backend> s_tab[N<Tag>] ;
@@ -187,11 +198,13 @@ namespace Backends {
 			static JobStartThread                        _s_job_start_thread              ;
 			static JobMngtThread                         _s_job_mngt_thread               ;
 			static JobEndThread                          _s_job_end_thread                ;
+			static JobRelayThread                        _s_job_relay_thread              ;                // receives messages forwarded by per-host relays, one connection per relay
 			static ::jthread                             _s_heartbeat_thread              ;
 			static SmallIds<SmallId,true/*ThreadSafe*/>  _s_small_ids                     ;
 			static Atomic<JobIdx>                        _s_starting_job                  ;                // this job is starting when _starting_job_mutex is locked
 			static Mutex<MutexLvl::StartJob>             _s_starting_job_mutex            ;
 			static ::map<Job,StartEntry>                 _s_start_tab                     ;                // use map instead of umap because heartbeat iterates over while tab is moving
+			static ::umap<Job,StartCtx>                  _s_direct_starts                 ;                // start info provided to job_exec, waiting for its report
 			static Workload                              _s_workload                      ;                // book keeping of workload
 			static ::map <Pdate,JobExec>                 _s_deferred_report_queue_by_date ;
 			static ::umap<Job  ,Pdate  >                 _s_deferred_report_queue_by_job  ;
@@ -218,6 +231,11 @@ namespace Backends {
 			virtual void                     heartbeat(          ) {                                     } // regularly called between launch and start
 			virtual ::pair_s<HeartbeatState> heartbeat(Job       ) { return {{},HeartbeatState::Alive} ; } // regularly called between launch and start, initially with enough delay for job to connect
 			//
+			virtual int/*sig*/ suspend(Job) { return 0 ; }                                                 // release resources of a started job waiting for direct deps, return signal to send to job (0 if none)
+			virtual void       resume (Job) {             }                                                // re-acquire resources released by suspend
+			//
+			virtual ::string placement(Job) const { return {} ; }                                          // cpus and memory nodes job is bound to, if any, for user information
+			//
 			virtual ::vmap_ss mk_lcl( ::vmap_ss&& /*rsrcs*/ , ::vmap_s<size_t> const& /*capacity*/ , JobIdx ) const { return {} ; } // map resources for this backend to local resources
 		//
 		virtual ::vmap_s<size_t> const& capacity() const { FAIL_PROD("only for local backend") ; }                              // NO_COV
@@ -266,6 +284,7 @@ namespace Backends {
 	//
 	#define SLCK _s_mutex.swear_locked()
 	inline ::string/*msg*/          Backend::s_start            ( Tag t , Job j            ) { SLCK ; Trace trace(BeChnl,"s_start"            ,t,j  ) ; return s_tab[+t]->start            (j  ) ; }
+	inline ::string                 Backend::s_placement        ( Tag t , Job j            ) { SLCK ;                                                  return s_tab[+t]->placement        (j  ) ; }
 	inline ::pair_s<bool/*retry*/>  Backend::s_end              ( Tag t , Job j , Status s ) { SLCK ; Trace trace(BeChnl,"s_end"              ,t,j,s) ; return s_tab[+t]->end              (j,s) ; }
 	inline ::vector<Job>            Backend::s_kill_waiting_jobs( Tag t , Req r            ) { SLCK ; Trace trace(BeChnl,"s_kill_waiting_jobs",t,r  ) ; return s_tab[+t]->kill_waiting_jobs(r  ) ; }
 	inline void                     Backend::s_kill_job         ( Tag t , Job j            ) { SLCK ; Trace trace(BeChnl,"s_kill_job"         ,t,j  ) ; return s_tab[+t]->kill_job         (j  ) ; }
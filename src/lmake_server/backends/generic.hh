@@ -5,8 +5,6 @@
 
 #include "core.hh" // /!\ must be first to include Python.h first
 
-// XXX! : rework to maintain an ordered list of waiting_queues in ReqEntry to avoid walking through all rsrcs for each launched job
-
 // a job may have 3 states :
 // - waiting : job has been submitted and is retained here until we can spawn it
 // - queued  : job has been spawned but has not yet started
@@ -137,10 +135,11 @@ namespace Backends {
 		void operator>>(::string& os) const {                           // START_OF_NO_COV
 			os << "SpawnedEntry(" ;
 			if (!zombie) {
-				/**/          os <<      rsrcs ;
-				if (id!=NoId) os << ','<<id    ;
-				if (started ) os << ",started" ;
-				if (verbose ) os << ",verbose" ;
+				/**/           os <<      rsrcs   ;
+				if (id!=NoId ) os << ','<<id      ;
+				if (started  ) os << ",started"   ;
+				if (verbose  ) os << ",verbose"   ;
+				if (suspended) os << ",suspended" ;
 			}
 			os << ')' ;
 		}                                                               // END_OF_NO_COV
@@ -153,6 +152,7 @@ namespace Backends {
 		Atomic<bool                           > verbose       ;
 		Atomic<bool                           > zombie        ;         // if true <=> entry waiting for suppression
 		Atomic<bool                           > hold          ;         // when held, entry cannot be destroyed
+		bool                                    suspended     = false ; // if true <=> job waits for direct deps and its resources are released
 	} ;
 
 	// we could maintain a list of reqs sorted by eta as we have open_req to create entries, close_req to erase them and new_req_etas to reorder them upon need
@@ -179,7 +179,8 @@ namespace Backends {
 			iterator       find(Job j)       { iterator       res = _tab.find(j) ; if ( res==_tab.end() || res->second.zombie ) return _tab.end() ; else return res ; }
 			// services
 			iterator create( GenericBackend const& be , Job j , Rsrcs const& rsrcs , Rsrcs const& rounded_rsrcs ) {
-				be.acquire_rsrcs(rounded_rsrcs) ;
+				be.acquire_rsrcs(  rounded_rsrcs) ;
+				be.place        (j,rounded_rsrcs) ;
 				return _tab.try_emplace(j,rsrcs,rounded_rsrcs).first ;
 			}
 			void start( GenericBackend const& be , iterator&& it ) {
@@ -194,8 +195,10 @@ namespace Backends {
 			void end( GenericBackend const& be , iterator&& it ) {
 				SpawnedEntry& se = it->second ;
 				SWEAR(!se.zombie) ;
-				if ( !se.started)   be.start_rsrcs(se.rounded_rsrcs) ;
-				/**/                be.end_rsrcs  (se.rounded_rsrcs) ;
+				if ( !se.started)   be.start_rsrcs (se.rounded_rsrcs) ;
+				if ( se.suspended)  be.resume_rsrcs(se.rounded_rsrcs) ;
+				/**/                be.end_rsrcs   (se.rounded_rsrcs) ;
+				/**/                be.unplace     (it->first       ) ;
 				if (!se.hold    )   _tab.erase(it)                   ;
 				else              { se.zombie = true ; _zombies.push_back(it->first) ; } // _launch may hold pointers with no lock, so dont physically erase entries
 				#ifndef NDEBUG
@@ -230,15 +233,47 @@ namespace Backends {
 			// service
 			void clear() {
 				waiting_queues.clear() ;
+				queue_heads   .clear() ;
 				waiting_jobs  .clear() ;
 			}
+			void push( Rsrcs const& rs , PressureEntry const& pe ) {
+				::set<PressureEntry>& q = waiting_queues[rs] ;
+				if (+q) {
+					if (*q.begin()<pe) { q.insert(pe) ; return ; }                 // head is unchanged
+					queue_heads.erase(*q.begin()) ;
+				}
+				q.insert(pe) ;
+				queue_heads.try_emplace(pe,rs) ;
+			}
+			// return new head of queue if pe was its head and queue is not empty
+			typename ::map<PressureEntry,Rsrcs>::iterator pop( Rsrcs const& rs , PressureEntry const& pe ) {
+				auto                  it = waiting_queues.find(rs) ; SWEAR(it!=waiting_queues.end(),rs) ;
+				::set<PressureEntry>& q  = it->second              ;
+				if (*q.begin()!=pe) {
+					size_t n_erased = q.erase(pe) ; SWEAR(n_erased==1,rs,pe.job) ;
+					return queue_heads.end() ;                                     // head is unchanged
+				}
+				queue_heads.erase(pe) ;
+				q.erase(q.begin()) ;
+				if (!q) { waiting_queues.erase(it) ; return queue_heads.end() ; } // last entry for this rsrcs, erase the entire queue
+				return queue_heads.try_emplace(*q.begin(),rs).first ;
+			}
 			// data
 			::umap<Rsrcs,::set<PressureEntry>> waiting_queues ;
+			::map <PressureEntry,Rsrcs       > queue_heads    ;         // head of each waiting queue, highest pressure first
 			::umap<Job,CoarseDelay           > waiting_jobs   ;
 			JobIdx                             n_jobs         = 0     ; // manage -j option (if >0 no more than n_jobs can be launched on behalf of this req)
 			bool                               verbose        = false ;
 		} ;
 
+		struct LaunchDescr {
+			Job              job      ;
+			::vector<ReqIdx> reqs     ;
+			::vector_s       cmd_line ;
+			Pdate            prio     ;
+			SpawnedEntry*    entry    = nullptr ;
+		} ;
+
 		// specialization
 		virtual void sub_config( ::vmap_ss const& /*dct*/ , ::vmap_ss const& /*env*/ ) {}                     // NO_COV meant to be overridden
 		//
@@ -250,6 +285,11 @@ namespace Backends {
 		virtual bool/*ok*/                fit_now      ( Rsrcs     const&             ) const = 0 ;           // if true      => job with such resources can be spawned now
 		virtual void                      start_rsrcs  ( Rsrcs     const&             ) const {}              // handle resources at start of job
 		virtual void                      end_rsrcs    ( Rsrcs     const&             ) const {}              // handle resources at end   of job
+		virtual void                      suspend_rsrcs( Rsrcs     const&             ) const {}              // release resources while job waits for direct deps
+		virtual void                      resume_rsrcs ( Rsrcs     const&             ) const {}              // re-acquire resources released by suspend_rsrcs, even if they do not fit
+		virtual int/*sig*/                suspend_sig  (                              ) const { return 0  ; } // signal sent to suspended jobs so they can release what they hold (e.g. licences)
+		virtual void                      place        ( Job , Rsrcs const&           ) const {}              // allocate job specific resources (e.g. cpus) once job is decided to be launched
+		virtual void                      unplace      ( Job                          ) const {}              // release them when job entry is discarded, whatever the reason
 		virtual ::vmap_ss                 export_      ( RsrcsData const&             ) const = 0 ;           // export resources in   a publicly manageable form
 		virtual RsrcsData                 import_      ( ::vmap_ss     && , Req , Job ) const = 0 ;           // import resources from a publicly manageable form
 		//
@@ -259,6 +299,21 @@ namespace Backends {
 		virtual void                     kill_queued_job     (       SpawnedEntry const&          ) const = 0 ;                                   //                   // .
 		//
 		virtual SpawnId launch_job( ::stop_token , Job , ::vector<ReqIdx> const& , Pdate prio , ::vector_s const& cmd_line , SpawnedEntry const& ) const = 0 ;
+		// launched must be called exactly once for each job, as early as possible as job start waits for it
+		// default is to launch jobs one by one, backends may override it to group submissions
+		virtual void launch_jobs( ::stop_token st , ::vector<LaunchDescr> const& lds ) {
+			Trace trace(BeChnl,"launch_jobs",lds.size()) ;
+			for( LaunchDescr const& ld : lds ) {
+				try {
+					SpawnId id = launch_job( st , ld.job , ld.reqs , ld.prio , ld.cmd_line , *ld.entry ) ; // XXX! : manage errors, for now rely on heartbeat
+					trace("child",ld.job,ld.prio,id,ld.cmd_line) ;
+					launched( ld , id ) ;
+				} catch (::string const& e) {
+					trace("fail",ld.job,ld.prio,e) ;
+					launched( ld , e ) ;
+				}
+			}
+		}
 		//
 		::vmap_ss mk_lcl( ::vmap_ss&& rsrcs , ::vmap_s<size_t> const& capacity , JobIdx ) const override { // START_OF_NO_COV system dependent, transform remote resources into local resources
 			::umap_s<size_t> capa   = mk_umap(capacity) ;
@@ -322,9 +377,9 @@ namespace Backends {
 			}
 			re.waiting_jobs[job] = pressure ;
 			waiting_jobs.emplace( job , WaitEntry(rs,submit_info,re.verbose) ) ;
-			re.waiting_queues[{New,rd.round(self)}].insert({pressure,job})     ;
-			if (!_oldest_submitted_job     ) _oldest_submitted_job = New ;
-			if (re.waiting_jobs.size()>1000) launch() ;                                                         // if too many jobs are waiting, ensure launch process is running
+			re.push( {New,rd.round(self)} , {pressure,job} ) ;
+			if (!_oldest_submitted_job          ) _oldest_submitted_job = New ;
+			if (!(re.waiting_jobs.size()%1000)) launch() ;                                                      // if too many jobs are waiting, ensure launch process runs, but not at each submit
 		}
 		void add_pressure( Job job , Req req , SubmitInfo const& submit_info ) override {
 			Trace trace(BeChnl,"add_pressure",job,req,submit_info) ;
@@ -342,7 +397,7 @@ namespace Backends {
 			trace("adjusted_pressure",pressure) ;
 			//
 			re.waiting_jobs[job] = pressure ;
-			re.waiting_queues[we.rsrcs.round(self)].insert({pressure,job}) ;
+			re.push( we.rsrcs.round(self) , {pressure,job} ) ;
 			we.submit_info |= submit_info ;
 			we.verbose     |= re.verbose  ;
 			we.n_reqs++ ;
@@ -352,14 +407,14 @@ namespace Backends {
 			auto      it = waiting_jobs.find(job) ;
 			//
 			if (it==waiting_jobs.end()) return ;                                                                // job is not waiting anymore, ignore
-			WaitEntry           & we           = it->second                                 ;
-			CoarseDelay         & old_pressure = re.waiting_jobs  .at(job                 ) ;                   // job must be known
-			::set<PressureEntry>& q            = re.waiting_queues.at(we.rsrcs.round(self)) ;                   // including for this req
-			CoarseDelay           pressure     = submit_info.pressure                       ;
+			WaitEntry  & we           = it->second                ;
+			CoarseDelay& old_pressure = re.waiting_jobs.at(job)   ;                                             // job must be known
+			Rsrcs        rrs          = we.rsrcs.round(self)      ;                                             // including for this req
+			CoarseDelay  pressure     = submit_info.pressure      ;
 			Trace trace("set_pressure","pressure",pressure) ;
 			we.submit_info |= submit_info ;
-			q.erase ({old_pressure,job}) ;
-			q.insert({pressure    ,job}) ;
+			re.pop ( rrs , {old_pressure,job} ) ;
+			re.push( rrs , {pressure    ,job} ) ;
 			old_pressure = pressure ;
 		}
 		::string start(Job job) override {
@@ -381,6 +436,23 @@ namespace Backends {
 			if ( n_n_jobs || call_launch_after_end() ) _launch_queue.wakeup() ;                                 // if we have a Req limited by n_jobs, we may have to launch a job
 			return digest ;
 		}
+		int/*sig*/ suspend(Job j) override {
+			auto          it = spawned_jobs.find(j) ; if (it==spawned_jobs.end()) return 0 ;                    // job was killed in the mean time
+			SpawnedEntry& se = it->second           ; SWEAR(se.started) ;
+			if (se.suspended) return 0 ;
+			Trace trace(BeChnl,"suspend",j) ;
+			se.suspended = true ;
+			suspend_rsrcs(se.rounded_rsrcs) ;
+			_launch_queue.wakeup() ;                                                                            // released resources may allow waiting jobs to be launched
+			return suspend_sig() ;
+		}
+		void resume(Job j) override {
+			auto          it = spawned_jobs.find(j) ; if (it==spawned_jobs.end()) return ;                      // job was killed in the mean time
+			SpawnedEntry& se = it->second           ; if (!se.suspended         ) return ;
+			Trace trace(BeChnl,"resume",j) ;
+			se.suspended = false ;
+			resume_rsrcs(se.rounded_rsrcs) ;
+		}
 		void heartbeat() override {
 			if ( _oldest_submitted_job.load()+g_config->heartbeat < Pdate(New) ) launch() ;                     // prevent jobs from being accumulated for too long
 		}
@@ -454,37 +526,40 @@ namespace Backends {
 			_launch_queue.wakeup() ;
 		}
 	protected :
+		void launched( LaunchDescr const& ld , SpawnId id ) {
+			SpawnedEntry& se = *ld.entry ;
+			SWEAR( id>=0 || id==NoId || id==FailedId , ld.job,id ) ;                                            // other negative id are used to mark special states
+			se.id = id ;
+			se.id.notify_one() ;
+			se.hold = false ;
+		}
+		void launched( LaunchDescr const& ld , ::string const& err ) {
+			msgs[ld.job] = err ;
+			launched( ld , FailedId ) ;
+		}
 		void _launch(::stop_token st) {
-			struct LaunchDescr {
-				::vector<ReqIdx> reqs     ;
-				::vector_s       cmd_line ;
-				Pdate            prio     ;
-				SpawnedEntry*    entry    = nullptr ;
-			} ;
 			for( auto [req,eta] : Req::s_etas() ) {                                                             // /!\ it is forbidden to dereference req without taking Req::s_reqs_mutex first
 				Trace trace(BeChnl,"launch",req) ;
-				::vmap<Job,LaunchDescr> launch_descrs ;
+				::vector<LaunchDescr> launch_descrs ;
 				{	TraceLock lock { _s_mutex , BeChnl , "launch" } ;
 					auto      rit  = reqs.find(+req)                ;
 					spawned_jobs.flush() ;                                                                      // do some cleanup while we hold the lock and we are holding no entries
 					if (rit==reqs.end()) continue ;
-					JobIdx                              n_jobs = rit->second.n_jobs         ;
-					::umap<Rsrcs,::set<PressureEntry>>& queues = rit->second.waiting_queues ;
+					JobIdx                      n_jobs = rit->second.n_jobs      ;
+					::map<PressureEntry,Rsrcs>& heads  = rit->second.queue_heads ;
+					auto                        hit    = heads.begin()           ;                          // queues before hit do not fit, and they cannot fit later as resources are only acquired
 					while (!( n_jobs && spawned_jobs.size()>=n_jobs )) {                                        // cannot have more than n_jobs running jobs because of this req, process next req
-						auto candidate = queues.end() ;
-						for( auto it=queues.begin() ; it!=queues.end() ; it++ ) {
-							if ( candidate!=queues.end() && it->second.begin()->pressure<=candidate->second.begin()->pressure ) continue ;
-							if (fit_now(it->first)) candidate = it ;                                                                           // continue to find a better candidate
-						}
-						if (candidate==queues.end()) break ;                                                                                   // nothing for this req, process next req
+						while ( hit!=heads.end() && !fit_now(hit->second) ) hit++ ;
+						if (hit==heads.end()) break ;                                                           // nothing for this req, process next req
 						//
-						::set<PressureEntry>& pressure_set = candidate->second       ;
-						auto                  pressure1    = pressure_set.begin()    ; SWEAR(pressure1!=pressure_set.end(),candidate->first) ; // a candidate with no pressure ?
-						Pdate                 prio         = eta-pressure1->pressure ;
-						Job                   j            = pressure1->job          ;
-						auto                  wit          = waiting_jobs.find(j)    ;
+						PressureEntry pe   = hit->first           ;                                                 // copy as entry is erased below
+						Rsrcs         rrs  = hit->second          ;                                                 // .
+						Pdate         prio = eta-pe.pressure      ;
+						Job           j    = pe.job               ;
+						auto          wit  = waiting_jobs.find(j) ;
+						hit++ ;
 						//
-						SpawnedEntry& se = spawned_jobs.create( self , j , wit->second.rsrcs , candidate->first )->second ;
+						SpawnedEntry& se = spawned_jobs.create( self , j , wit->second.rsrcs , rrs )->second ;
 						//
 						se.timeout = wit->second.submit_info.timeout ;
 						se.verbose = wit->second.verbose             ;
@@ -496,44 +571,24 @@ namespace Backends {
 						for( Req r : rs ) {
 							ReqEntry& re   = reqs.at(r)              ;
 							auto      wit1 = re.waiting_jobs.find(j) ;
-							if (r!=req) {
-								auto                  wit2 = re.waiting_queues.find(candidate->first) ;
-								::set<PressureEntry>& pes  = wit2->second                             ;
-								PressureEntry         pe   { wit1->second , j }                       ;                                        // /!\ pressure is job pressure for r, not for req
-								SWEAR(pes.contains(pe)) ;
-								if (pes.size()==1) re.waiting_queues.erase(wit2) ;                                                             // last entry for this rsrcs, erase the entire queue
-								else               pes              .erase(pe  ) ;
-							}
+							auto      nhit = re.pop( rrs , {wit1->second,j} ) ;                                 // /!\ pressure is job pressure for r, not for req
 							re.waiting_jobs.erase(wit1) ;
+							if ( r!=req || nhit==heads.end()                 ) continue   ;
+							if ( hit==heads.end() || nhit->first<hit->first ) hit = nhit ;                      // new head of launched queue may lie before hit
 						}
-						if (pressure_set.size()==1) queues      .erase(candidate) ;                                                            // last entry for this rsrcs, erase the entire queue
-						else                        pressure_set.erase(pressure1) ;
-						launch_descrs.emplace_back( j , LaunchDescr{ rs , acquire_cmd_line( T , j , ::move(rs) , export_(*se.rsrcs) , ::move(wit->second.submit_info) ) , prio , &se } ) ;
+						launch_descrs.push_back({ j , rs , acquire_cmd_line( T , j , ::move(rs) , export_(*se.rsrcs) , ::move(wit->second.submit_info) ) , prio , &se }) ;
 						waiting_jobs.erase(wit) ;
 					}
-					for( auto& [_,ld] : launch_descrs ) {                                         // as late as possible, while we hold the lock, so if killed, we miss no job
+					for( LaunchDescr& ld : launch_descrs ) {                // as late as possible, while we hold the lock, so if killed, we miss no job
 						ld.entry->id   = StartingId ;
 						ld.entry->hold = true       ;
 					}
 				}
-				for( auto& [j,ld] : launch_descrs ) {
-					SpawnedEntry& se = *ld.entry ;
-					if (se.zombie) {                                                              // fast path : avoid launching job if already killed, ...
-						se.id = NoId ;                                                            // ... if not done and job is not killed, it will send its start message and get a mismatch
-					} else {
-						try {
-							se.id = launch_job( st , j , ld.reqs , ld.prio , ld.cmd_line , se ) ; // XXX! : manage errors, for now rely on heartbeat
-							SWEAR( se.id>=0 , j ) ;                                               // negative id are used to mark special states
-							trace("child",j,ld.prio,se.id,ld.cmd_line) ;
-						} catch (::string const& e) {
-							trace("fail",j,ld.prio,e) ;
-							se.id   = FailedId ;
-							msgs[j] = e        ;
-						}
-					}
-					se.id.notify_one() ;
-					se.hold = false ;
-				}
+				::vector<LaunchDescr> to_launch ; to_launch.reserve(launch_descrs.size()) ;
+				for( LaunchDescr& ld : launch_descrs )
+					if (ld.entry->zombie) launched( ld , NoId )          ;  // fast path : avoid launching job if already killed, if not done and job is not killed, ...
+					else                  to_launch.push_back(::move(ld)) ; // ... it will send its start message and get a mismatch
+				if (+to_launch) launch_jobs( st , to_launch ) ;
 				trace("done") ;
 			}
 		}
@@ -7,9 +7,18 @@
 
 // PER_BACKEND : there must be a file describing each backend (providing the sub-backend class, deriving from GenericBackend if possible (simpler), else Backend)
 
+#include <linux/mempolicy.h> // MPOL_BIND
+#include <sys/syscall.h>
+
 using namespace Disk ;
 using namespace Hash ;
 
+enum class LocalPlacement : uint8_t {
+	None
+,	Cpu  // jobs are bound to cpus according to their cpu resource, packed onto NUMA nodes
+,	Numa // same as Cpu, and memory is bound to the NUMA nodes of these cpus
+} ;
+
 namespace Backends::Local {
 
 	struct LocalBackend ;
@@ -44,7 +53,52 @@ namespace Backends::Local {
 
 namespace Backends::Local {
 
-	constexpr Tag MyTag = Tag::Local ;
+	constexpr Tag    MyTag            = Tag::Local              ;
+	constexpr size_t DirectStartMaxSz = 1<<20                   ; // start info is written to job_exec stdin before it reads it, pipe is grown as necessary above this size
+	constexpr size_t PipeSafeSz       = 1<<15                   ; // start info that fits in this size can be written to any pipe (64k by default) without blocking
+	constexpr size_t MaxNumaNodes     = 1024                    ; // max number of NUMA nodes memory can be bound to
+	constexpr size_t NodeMaskBits     = 8*sizeof(unsigned long) ;
+
+	struct WarmJobExec {
+		pid_t pid = 0 ;
+		AcFd  fd  ;     // write side of job_exec stdin
+	} ;
+
+	struct CpuEntry {
+		uint32_t id   = 0 ; // as known by the kernel
+		uint32_t node = 0 ; // NUMA node this cpu belongs to
+		uint32_t load = 0 ; // number of jobs bound to this cpu
+	} ;
+
+	struct PlacementEntry {
+		::vector<uint32_t> cpus     = {}    ; // indexes in LocalBackend::_cpus
+		bool               mem_bind = false ; // if true, memory is bound to the NUMA nodes of cpus
+	} ;
+
+	// parse cpu lists as found in /sys, e.g. 0-3,8-11
+	inline ::vector<uint32_t> parse_cpu_list(::string const& txt) {
+		::vector<uint32_t> res ;
+		for( ::string const& r : split(txt,',') ) {
+			if (!r) continue ;
+			size_t   pos   = r.find('-')                                                      ;
+			uint32_t first = from_string<uint32_t>(r.substr(0,pos))                           ;
+			uint32_t last  = pos==Npos ? first : from_string<uint32_t>(r.substr(pos+1)) ;
+			for( uint32_t c : iota(first,last+1) ) res.push_back(c) ;
+		}
+		return res ;
+	}
+	// reverse of parse_cpu_list, ids must be sorted
+	inline ::string cpu_list_str(::vector<uint32_t> const& ids) {
+		::string res ;
+		for( size_t i=0 ; i<ids.size() ; ) {
+			size_t j = i+1 ; while ( j<ids.size() && ids[j]==ids[j-1]+1 ) j++ ;
+			if (+res ) res << ','          ;
+			/**/       res << ids[i]       ;
+			if (j>i+1) res << '-'<<ids[j-1] ;
+			i = j ;
+		}
+		return res ;
+	}
 
 	struct LocalBackend : GenericBackend<MyTag,'L'/*LaunchThreadKey*/,RsrcsData> {
 		// init
@@ -68,11 +122,35 @@ namespace Backends::Local {
 
 		// services
 
-		void sub_config( ::vmap_ss const& dct , ::vmap_ss const& env_ ) override {
+		void sub_config( ::vmap_ss const& dct_ , ::vmap_ss const& env_ ) override {
 			// add an implicit resource <single> to manage jobs localized from remote backends
-			Trace trace(BeChnl,"Local::config",dct) ;
+			Trace trace(BeChnl,"Local::config",dct_) ;
 			static bool s_first_time = true ; bool first_time = s_first_time ; s_first_time = false ;
 			//
+			::vmap_ss      dct          ;
+			size_t         pool_sz      = 0                    ;
+			bool           direct_start = false                ;
+			int            suspend_sig  = 0                    ;
+			LocalPlacement placement    = LocalPlacement::None ;
+			for( auto const& [k,v] : dct_ ) {
+				if ( k!="job_exec_pool" && k!="direct_start" && k!="suspend_sig" && k!="placement" ) { dct.emplace_back(k,v) ; continue ; } // all other entries are resources
+				if (k=="placement") {
+					throw_unless( can_mk_enum<LocalPlacement>(v) , "wrong value for entry ",k,": ",v ) ;
+					placement = mk_enum<LocalPlacement>(v) ;
+					continue ;
+				}
+				try {
+					if      (k=="job_exec_pool") pool_sz      = from_string<size_t>(v)    ;
+					else if (k=="direct_start" ) direct_start = from_string<int   >(v)!=0 ;
+					else                         suspend_sig  = from_string<int   >(v)    ;
+				} catch (::string const&) { throw cat("wrong value for entry ",k,": ",v) ; }
+			}
+			throw_unless( suspend_sig>=0 && suspend_sig<NSIG , "bad signal for entry suspend_sig: ",suspend_sig ) ;
+			_direct_start = direct_start ;
+			_suspend_sig  = suspend_sig  ;
+			if ( placement!=LocalPlacement::None && !_cpus ) _init_topology() ;                                        // topology is read once, currently placed jobs keep their cpus
+			_placement = placement ;
+			//
 			rsrc_keys.reserve(dct.size()+1/*<single>*/) ;
 			bool seen_single = false ;
 			if (first_time) {
@@ -115,7 +193,14 @@ namespace Backends::Local {
 				}
 				_env[i] = nullptr ;
 			}
-			trace("done") ;
+			::vector<pid_t> flushed ;
+			{	Lock lock { _pool_mutex } ;
+				for( WarmJobExec const& wje : _pool ) flushed.push_back(wje.pid) ;                                        // env may have changed, warm job_exec's exit when their stdin is closed
+				_pool.clear() ;
+				_pool_sz = pool_sz ;
+			}
+			for( pid_t pid : flushed ) _wait_queue.push(pid) ;
+			trace("done",pool_sz,STR(direct_start),placement,_cpus.size()) ;
 		}
 		::vmap_s<size_t> const& capacity() const override {
 			return public_capacity ;
@@ -147,9 +232,58 @@ namespace Backends::Local {
 			for( size_t i : iota(occupied.size()) ) SWEAR(occupied[i]<=capacity_[i]) ;
 		}
 		void end_rsrcs(Rsrcs const& rs) const override {
+			for( size_t i : iota(occupied.size()) ) SWEAR(occupied[i]>=(*rs)[i]) ;                                        // occupied may transiently exceed capacity after resume_rsrcs
 			occupied -= *rs ;
 			Trace trace(BeChnl,"occupied_rsrcs",rs,'-',occupied) ;
-			for( size_t i : iota(occupied.size()) ) SWEAR(occupied[i]<=capacity_[i]) ;
+		}
+		void suspend_rsrcs(Rsrcs const& rs) const override {
+			end_rsrcs(rs) ;
+		}
+		void resume_rsrcs(Rsrcs const& rs) const override {                                                              // job must resume anyway, launch will wait for occupied to go back below capacity
+			occupied += *rs ;
+			Trace trace(BeChnl,"occupied_rsrcs",rs,'+',occupied) ;
+		}
+		int/*sig*/ suspend_sig() const override {
+			return _suspend_sig ;
+		}
+		void place( Job job , Rsrcs const& rs ) const override {
+			if (_placement==LocalPlacement::None) return ;
+			auto     it = rsrc_idxs.find("cpu") ; if (it==rsrc_idxs.end()                ) return ;
+			uint32_t n  = (*rs)[it->second]     ; if ( !n || n>_cpus.size() || !_cpus ) return ;                  // no binding if job needs the whole host
+			Lock lock { _placement_mutex } ;
+			::map<uint32_t/*node*/,uint32_t/*n_idle*/> idles ;
+			for( CpuEntry const& ce : _cpus ) if (!ce.load) idles[ce.node]++ ;
+			// best fit : pick the node with the fewest idle cpus that can hold the whole job, so as to keep large holes for large jobs
+			size_t best_node = Npos ;
+			for( auto [node,n_idle] : idles ) if ( n_idle>=n && ( best_node==Npos || n_idle<idles[best_node] ) ) best_node = node ;
+			PlacementEntry pe { .mem_bind=_placement==LocalPlacement::Numa } ;
+			if (best_node!=Npos) {
+				for( uint32_t i : iota(uint32_t(_cpus.size())) ) if ( _cpus[i].node==best_node && !_cpus[i].load && pe.cpus.size()<n ) pe.cpus.push_back(i) ;
+			} else {                                                                                                   // job must span several nodes or cpus are over-subscribed (e.g. after resume) ...
+				::vector<uint32_t> idxs = mk_vector(iota(uint32_t(_cpus.size()))) ;                                   // ... take least loaded cpus, on nodes with most idle cpus
+				::sort( idxs , [&](uint32_t a , uint32_t b )->bool {
+					return ::tuple(_cpus[a].load,-int64_t(idles[_cpus[a].node]),a) < ::tuple(_cpus[b].load,-int64_t(idles[_cpus[b].node]),b) ;
+				} ) ;
+				idxs.resize(n) ;
+				::sort(idxs) ;                                                                                         // _cpus is sorted by node then id
+				pe.cpus = ::move(idxs) ;
+			}
+			for( uint32_t i : pe.cpus ) _cpus[i].load++ ;
+			Trace trace(BeChnl,"place",job,_placement_str(pe)) ;
+			_placements[job] = ::move(pe) ;
+		}
+		void unplace(Job job) const override {
+			if (!_cpus) return ;                                                                                       // fast path : placement was never used
+			Lock lock { _placement_mutex } ;
+			auto it = _placements.find(job) ; if (it==_placements.end()) return ;
+			for( uint32_t i : it->second.cpus ) { SWEAR(_cpus[i].load,job,i) ; _cpus[i].load-- ; }
+			_placements.erase(it) ;
+		}
+		::string placement(Job job) const override {
+			if (!_cpus) return {} ;                                                                                    // fast path : placement was never used
+			Lock lock { _placement_mutex } ;
+			auto it = _placements.find(job) ; if (it==_placements.end()) return {} ;
+			return _placement_str(it->second) ;
 		}
 		//
 		::string start_job( Job , SpawnedEntry const& se ) const override {
@@ -173,16 +307,56 @@ namespace Backends::Local {
 			_wait_queue.push(se.id) ;                                                                       // defer wait in case job_exec process does some time consuming book-keeping
 		}
 		SpawnId launch_job( ::stop_token , Job job , ::vector<ReqIdx> const& , Pdate /*prio*/ , ::vector_s const& cmd_line , SpawnedEntry const& se ) const override {
-			::vector<const char*> cmd_line_ ; cmd_line_.reserve(cmd_line.size()+1) ;
+			::string stderr_file ; if (se.verbose) stderr_file = dir_guard(get_stderr_file(job)) ;
+			::string start_info  ; if (_direct_start) start_info = _s_direct_start(job) ;                                              // empty if job_exec must ask server
+			if (start_info.size()>DirectStartMaxSz) { _s_cancel_direct_start(job) ; start_info = {} ; }
+			bool     large_start = start_info.size()>PipeSafeSz ;                                                                      // start info does not fit in warm job_exec stdin
+			// prepare placement before cloning as child must be malloc free
+			cpu_set_t     cpu_set                              ; CPU_ZERO(&cpu_set) ;
+			unsigned long node_mask[MaxNumaNodes/NodeMaskBits] = {}    ;
+			bool          mem_bind                             = false ;
+			if (+_cpus) {
+				Lock lock { _placement_mutex } ;
+				if ( auto it=_placements.find(job) ; it!=_placements.end() ) {
+					mem_bind = it->second.mem_bind ;
+					for( uint32_t i : it->second.cpus ) {
+						CpuEntry const& ce = _cpus[i] ;
+						if (             ce.id  <CPU_SETSIZE  ) CPU_SET(ce.id,&cpu_set)                                   ;
+						if ( mem_bind && ce.node<MaxNumaNodes ) node_mask[ce.node/NodeMaskBits] |= 1ul<<(ce.node%NodeMaskBits) ;
+					}
+				}
+			}
+			bool const has_cpu_set   = CPU_COUNT(&cpu_set)>0   ;                                                                  // computed once for all as child is vfork'ed
+			bool const has_node_mask = has_cpu_set && mem_bind ;
+			if ( !has_cpu_set && !large_start )                                                                                       // warm job_exec's cannot be bound as they are already running
+				if ( pid_t pid=_launch_warm(cmd_line,stderr_file,start_info) ) return pid ;
+			//
+			AcPipe start_pipe ;
+			if (+start_info) {
+				start_pipe.open( O_CLOEXEC , true/*no_std*/ ) ;                                                                        // only job_exec must hold read side
+				if ( large_start && ::fcntl(start_pipe.write,F_SETPIPE_SZ,int(start_info.size()+PipeSafeSz))<0 ) {                     // grow pipe so that start info fits, ...
+					_s_cancel_direct_start(job) ;                                                                                      // ... else job_exec asks server as usual
+					start_info = {} ;
+					start_pipe.close() ;
+				} else {
+					OMsgBuf msg ; msg.add_serialized(start_info) ;
+					msg.send( start_pipe.write , {}/*key*/ ) ;                                                                         // start info fits in pipe, so this does not block
+					start_pipe.write.close() ;
+				}
+			}
+			::vector<const char*> cmd_line_ ; cmd_line_.reserve(cmd_line.size()+2) ;
 			for( ::string const& a : cmd_line ) cmd_line_.push_back(a.c_str()) ;
+			if (+start_info)                    cmd_line_.push_back("0"      ) ;                                                       // start info is read from stdin
 			/**/                                cmd_line_.push_back(nullptr  ) ;
 			// calling ::vfork is significantly faster as lmake_server is a heavy process, so walking the page table is a significant perf hit
-			::string    stderr_file  ;                        if (se.verbose) stderr_file = dir_guard(get_stderr_file(job)) ;
-			const char* stderr_c_str = stderr_file.c_str()  ;
+			const char* stderr_c_str = stderr_file.c_str() ;
 			pid_t       pid          = ::vfork()            ;                                                                          // NOLINT(clang-analyzer-security.insecureAPI.vfork)
 			// NOLINTBEGIN(clang-analyzer-unix.Vfork) allowed in Linux
 			if (!pid) {                                                                                                                // in child
 				// /!\ this section must be malloc free as malloc takes a lock that may be held by another thread at the time process is cloned
+				if (+start_pipe.read) { if ( int rc=::dup2( start_pipe.read , Fd::Stdin ) ; rc<0 ) ::_exit(+Rc::System) ; }            // dup2 clears O_CLOEXEC
+				if (has_cpu_set     ) ::sched_setaffinity( 0/*self*/ , sizeof(cpu_set) , &cpu_set )                  ;                  // best effort, placement is only an optimization, ...
+				if (has_node_mask   ) ::syscall( SYS_set_mempolicy , MPOL_BIND , node_mask , MaxNumaNodes )          ;                  // ... both are inherited through exec
 				if (se.verbose) {
 					int stderr_fd = ::open( stderr_c_str , O_WRONLY|O_TRUNC|O_CREAT , 0666 ) ; if (stderr_fd<0) ::_exit(+Rc::System) ; // we do *not* want the O_CLOEXEC flag ...
 					if (stderr_fd!=Fd::Stderr.fd) {                                                                                    // ... as we are precisely preparing fd for child
@@ -198,17 +372,101 @@ namespace Backends::Local {
 			// NOLINTEND(clang-analyzer-unix.Vfork) allowed in Linux
 			return pid ;
 		}
+	private :
+		// warm job_exec's are launched in advance with - as sole arg and wait for their actual args on stdin,
+		// so that exec, dynamic link and init are out of the critical path
+		// once launched, they are indistinguishable from cold ones, in particular their pid is the job id
+		WarmJobExec _spawn_warm(::string const& job_exec) const {
+			const char* argv[] = { job_exec.c_str() , "-" , nullptr } ;
+			Pipe        pipe   { New , O_CLOEXEC , true/*no_std*/ }   ;                                // only job_exec must hold read side, only we must hold write side
+			pid_t       pid    = ::vfork()                            ;                                // NOLINT(clang-analyzer-security.insecureAPI.vfork)
+			// NOLINTBEGIN(clang-analyzer-unix.Vfork) allowed in Linux
+			if (!pid) {                                                                                // in child
+				// /!\ this section must be malloc free as malloc takes a lock that may be held by another thread at the time process is cloned
+				if ( int rc=::dup2( pipe.read , Fd::Stdin ) ; rc<0 ) ::_exit(+Rc::System) ;            // dup2 clears O_CLOEXEC
+				::execve( argv[0] , const_cast<char**>(argv) , const_cast<char**>(_env.get()) ) ;
+				::_exit(+Rc::System) ;                                                                 // NO_COV defensive programming, in case exec fails
+			}
+			SWEAR_PROD( pid>0 , pid ) ;
+			// NOLINTEND(clang-analyzer-unix.Vfork) allowed in Linux
+			pipe.read.close() ;
+			return { pid , pipe.write } ;
+		}
+		// read host topology, restricted to cpus we are allowed to run on
+		void _init_topology() {
+			cpu_set_t allowed ; if (::sched_getaffinity(0/*self*/,sizeof(allowed),&allowed)!=0) CPU_ZERO(&allowed) ;
+			::vector_s node_dirs ;
+			try                     { node_dirs = lst_dir_s(::string("/sys/devices/system/node/")) ; }
+			catch (::string const&) {                                                              } // no NUMA info
+			for( ::string const& nd : node_dirs ) {
+				if (!nd.starts_with("node")) continue ;
+				try {
+					uint32_t node     = from_string<uint32_t>(nd.substr(4))                          ;
+					::string cpu_list = AcFd(cat("/sys/devices/system/node/",nd,"/cpulist")).read() ; while ( +cpu_list && cpu_list.back()=='\n' ) cpu_list.pop_back() ;
+					for( uint32_t c : parse_cpu_list(cpu_list) ) if ( c<CPU_SETSIZE && CPU_ISSET(c,&allowed) ) _cpus.push_back({ .id=c , .node=node }) ;
+				} catch (::string const&) {}                                                           // ignore unreadable nodes
+			}
+			if (!_cpus) for( uint32_t c : iota(uint32_t(CPU_SETSIZE)) ) if (CPU_ISSET(c,&allowed)) _cpus.push_back({ .id=c }) ; // no NUMA info, consider a single node
+			::sort( _cpus , [](CpuEntry const& a , CpuEntry const& b )->bool { return ::pair(a.node,a.id) < ::pair(b.node,b.id) ; } ) ;
+			Trace trace(BeChnl,"_init_topology",_cpus.size()) ;
+		}
+		::string _placement_str(PlacementEntry const& pe) const {
+			::vector<uint32_t> ids   ; for( uint32_t i : pe.cpus ) ids  .push_back(_cpus[i].id  ) ;
+			::vector<uint32_t> nodes ; for( uint32_t i : pe.cpus ) if ( !nodes || nodes.back()!=_cpus[i].node ) nodes.push_back(_cpus[i].node) ; // pe.cpus is sorted by node
+			::sort(ids) ;
+			::string res = cat("cpus:",cpu_list_str(ids)," nodes:",cpu_list_str(nodes)) ;
+			if (pe.mem_bind) res << " (memory bound)" ;
+			return res ;
+		}
+		// return 0 if no warm job_exec is available
+		pid_t _launch_warm( ::vector_s const& cmd_line , ::string const& stderr_file , ::string const& start_info ) const {
+			Trace trace(BeChnl,"_launch_warm",cmd_line[0]) ;
+			::vector<pid_t> dead ;
+			pid_t           res  = 0 ;
+			{	Lock lock { _pool_mutex } ;
+				if (!_pool_sz) return 0 ;
+				if (cmd_line[0]!=_pool_job_exec) {                                                     // first launch or job_exec moved
+					for( WarmJobExec const& wje : _pool ) dead.push_back(wje.pid) ;
+					_pool.clear() ;
+					_pool_job_exec = cmd_line[0] ;
+				}
+				::vector_s args { cmd_line.begin()+1 , cmd_line.end() } ;
+				if (+start_info) args.push_back("0") ;                                                 // start info is read from stdin, right after args
+				/**/             args.push_back(stderr_file) ;
+				OMsgBuf msg { args } ; if (+start_info) msg.add_serialized(start_info) ;
+				while ( !res && _pool.size() ) {
+					WarmJobExec wje = ::move(_pool.front()) ; _pool.pop_front() ;                      // oldest is most probably ready
+					try                     { msg.send(wje.fd,{}/*key*/) ; res = wje.pid ;           } // msg fits in pipe, so this does not block
+					catch (::string const&) { trace("dead",wje.pid) ;      dead.push_back(wje.pid) ; } // warm job_exec died while waiting, try next one
+				}
+				while (_pool.size()<_pool_sz) _pool.push_back(_spawn_warm(_pool_job_exec)) ;           // refill for next launches
+			}
+			for( pid_t pid : dead ) _wait_queue.push(pid) ;
+			trace("done",res) ;
+			return res ;
+		}
 
 		// data
+	public :
 		::umap_s<size_t>  rsrc_idxs       ;
 		::vector_s        rsrc_keys       ;
 		RsrcsData         capacity_       ;
 		RsrcsData mutable occupied        ;
 		::vmap_s<size_t>  public_capacity ;
 	private :
-		QueueThread<pid_t> mutable  _wait_queue ;
-		::unique_ptr<const char*[]> _env        ; // directly call ::execve without going through Child to improve perf
-		::vector_s                  _env_vec    ; // hold _env strings of the form key=value
+		QueueThread<pid_t>         mutable _wait_queue      ;
+		::unique_ptr<const char*[]>        _env             ;         // directly call ::execve without going through Child to improve perf
+		::vector_s                         _env_vec         ;         // hold _env strings of the form key=value
+		Mutex<>                    mutable _pool_mutex      ;
+		::deque<WarmJobExec>       mutable _pool            ;         // warm job_exec's waiting for a job, oldest first
+		::string                   mutable _pool_job_exec   ;         // job_exec used to launch _pool
+		size_t                             _pool_sz         = 0     ;
+		bool                               _direct_start    = false ; // if true, provide start info to job_exec at launch time
+		int                                _suspend_sig     = 0     ; // signal sent to jobs waiting for direct deps (0 if none)
+		LocalPlacement                     _placement       = {}    ;
+		::vector<CpuEntry>         mutable _cpus            ;         // cpus available for placement, sorted by NUMA node then id, empty if placement was never used
+		Mutex<>                    mutable _placement_mutex ;         // protect cpu loads and _placements as jobs are launched with no lock
+		::umap<Job,PlacementEntry> mutable _placements      ;
 
 	} ;
 
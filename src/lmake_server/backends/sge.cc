@@ -7,6 +7,8 @@
 
 #include "generic.hh" // /!\ must be first because Python.h must be first
 
+#include <sys/mman.h> // memfd_create
+
 #include "disk.hh"
 #include "process.hh"
 
@@ -81,11 +83,21 @@ namespace Backends::Sge {
 
 	using SgeId = uint32_t ;
 
-	void     sge_cancel      (::pair<SgeBackend const*,SgeId> const&) ;
-	void     sge_sense_daemon(SgeBackend const&                     ) ;
-	::string sge_mk_name     (::string&&                            ) ;
+	// array tasks are numbered from 1 and are identified by the upper bits of their spawn id, 0 meaning a plain job
+	inline SpawnId  sge_mk_spawn_id( SgeId job , uint32_t task=0 ) { return SpawnId(task)<<32 | job ; }
+	inline SgeId    sge_spawn_job  ( SpawnId id                  ) { return SgeId   (id    )       ; }
+	inline uint32_t sge_spawn_task ( SpawnId id                  ) { return uint32_t(id>>32)       ; }
+	inline ::string sge_spawn_id_str(SpawnId id) {
+		if (!sge_spawn_task(id)) return cat(sge_spawn_job(id)                          ) ;
+		else                     return cat(sge_spawn_job(id),'.',sge_spawn_task(id)) ;    // SGE syntax
+	}
+
+	void     sge_cancel      (::pair<SgeBackend const*,SpawnId> const&) ;
+	void     sge_sense_daemon(SgeBackend const&                       ) ;
+	::string sge_mk_name     (::string&&                              ) ;
 
-	constexpr Tag MyTag = Tag::Sge ;
+	constexpr Tag    MyTag      = Tag::Sge ;
+	constexpr size_t MaxArraySz = 1000     ;
 
 	struct SgeBackend
 	:	             GenericBackend<MyTag,'G'/*LaunchThreadKey*/,RsrcsData>
@@ -115,7 +127,7 @@ namespace Backends::Sge {
 		}
 
 		// static data
-		static QueueThread<::pair<SgeBackend const*,SgeId>> _s_sge_cancel_thread ; // when a req is killed, a lot of queued jobs may be canceled, better to do it in a separate thread
+		static QueueThread<::pair<SgeBackend const*,SpawnId>> _s_sge_cancel_thread ; // when a req is killed, a lot of queued jobs may be canceled, better to do it in a separate thread
 
 		// accesses
 
@@ -140,6 +152,7 @@ namespace Backends::Sge {
 						case 'r' : if (k=="repo_key"         ) { repo_key          =                       v  ; continue ; }
 						/**/       if (k=="root"             ) { sge_root_s        = with_slash           (v) ; continue ; } break ;
 						case 't' : if (k=="tmp_resource"     ) { tmp_rsrc          =                       v  ; continue ; } break ;
+						case 'u' : if (k=="use_arrays"       ) { use_arrays        = from_string<bool    >(v) ; continue ; } break ;
 					DN}
 				} catch (::string const& e) { trace("bad_val",k,v) ; throw cat("wrong value for entry "    ,k+": ",v) ; }
 				/**/                        { trace("bad_key",k  ) ; throw cat("unexpected config entry : ",k       ) ; }
@@ -189,57 +202,64 @@ namespace Backends::Sge {
 		}
 		::string start_job( Job , SpawnedEntry const& se ) const override {
 			SWEAR(+se.rsrcs) ;
-			return cat("sge_id:",se.id.load()) ;
+			return cat("sge_id:",sge_spawn_id_str(se.id)) ;
 		}
 		::pair_s<bool/*retry*/> end_job( Job j , SpawnedEntry const& se , Status ) const override {
 			if (!se.verbose) return { {}/*msg*/      , true/*retry*/ } ;                            // common case, must be fast, if job is in error, better to ask slurm why, e.g. could be OOM
 			else             return { read_stderr(j) , true/*retry*/ } ;
 		}
+		void heartbeat() override {
+			Base::heartbeat() ;
+			_job_states_ok = false ;                                                                // called once per heartbeat round, take a new snapshot for next round
+		}
 		::pair_s<HeartbeatState> heartbeat_queued_job( Job job , SpawnedEntry const& se ) const override {
-			if (sge_exec_client({"qstat","-j",::to_string(se.id)})) return { {}/*msg*/ , HeartbeatState::Alive } ;
+			if (!_job_states_ok) _refresh_job_states() ;
+			Bool3 state = _job_state(se.id) ;                                                       // snapshot is taken with a single request to SGE daemon for all queued jobs
+			if (state==Maybe) {                                                                     // not in snapshot (e.g. submitted after it was taken), ask daemon
+				if (sge_exec_client({"qstat","-j",cat(sge_spawn_job(se.id))})) state = Yes ;
+			}
+			if (state==Yes) return { {}/*msg*/ , HeartbeatState::Alive } ;
 			::string msg ;
-			if (se.verbose) msg = read_stderr(job)               ;
-			else            msg = "lost job "+::to_string(se.id) ;
-			return { ::move(msg) , HeartbeatState::Lost } ;                                         // XXX! : try to distinguish between Lost and Err
+			if      (se.verbose) msg = read_stderr(job)                              ;
+			else if (state==No ) msg = "job in error state "+sge_spawn_id_str(se.id) ;
+			else                 msg = "lost job "          +sge_spawn_id_str(se.id) ;
+			if (state==Maybe) return { ::move(msg) , HeartbeatState::Lost } ;                       // XXX! : try to distinguish between Lost and Err
+			_s_sge_cancel_thread.push(::pair(this,se.id.load())) ;                                  // job in error state stays in queue, it must be explicitly deleted
+			return { ::move(msg) , HeartbeatState::Err } ;
 		}
 		void kill_queued_job(SpawnedEntry const& se) const override {
 			if (!se.zombie) _s_sge_cancel_thread.push(::pair(this,se.id.load())) ;                  // asynchronous (as faster and no return value) cancel
 		}
 		SpawnId launch_job( ::stop_token , Job j , ::vector<ReqIdx> const& reqs , Pdate /*prio*/ , ::vector_s const& cmd_line , SpawnedEntry const& se ) const override {
-			::vector_s sge_cmd_line = {
-				"qsub"
-			,	"-terse"
-			,	"-b"     , "y"
-			,	"-o"     ,                                                             "/dev/null"s
-			,	"-e"     , se.verbose ? *g_repo_root_s+dir_guard(get_stderr_file(j)) : "/dev/null"s
-			,	"-shell" , "n"
-			,	"-N"     , sge_mk_name(repo_key+Job(j)->name())
-			} ;
-			if (+env) {
-				::string env_str ;
-				First    first   ;
-				for( auto const& [k,v] : env ) env_str <<first("",",")<< k <<'='<< v ;
-				sge_cmd_line.emplace_back("-v"   ) ;
-				sge_cmd_line.emplace_back(env_str) ;
-			}
-			SWEAR(+reqs) ;                                                                                   // why launch a job if for no req ?
-			int16_t prio = ::max<int16_t>( reqs , [&](ReqIdx r) { return req_prios[r] ; } , Min<int16_t> ) ;
-			//
-			Rsrcs const& rs = se.rsrcs ;
-			if ( prio                 )           { sge_cmd_line.emplace_back("-p"   ) ; sge_cmd_line.push_back(               to_string(prio     )) ;   }
-			if ( +cpu_rsrc && rs->cpu )           { sge_cmd_line.emplace_back("-l"   ) ; sge_cmd_line.push_back(cpu_rsrc+'='+::to_string(rs->cpu  )) ;   }
-			if ( +mem_rsrc && rs->mem )           { sge_cmd_line.emplace_back("-l"   ) ; sge_cmd_line.push_back(mem_rsrc+'='+::to_string(rs->mem  )) ;   }
-			if ( +tmp_rsrc && rs->tmp )           { sge_cmd_line.emplace_back("-l"   ) ; sge_cmd_line.push_back(tmp_rsrc+'='+::to_string(rs->tmp  )) ;   }
-			for( auto const& [k,v] : rs->tokens ) { sge_cmd_line.emplace_back("-l"   ) ; sge_cmd_line.push_back(k       +'='+::to_string(v        )) ;   }
-			if ( +rs->hard            )           {                                      for( ::string const& s : rs->hard ) sge_cmd_line.push_back(s) ; }
-			if ( +rs->soft            )           { sge_cmd_line.emplace_back("-soft") ; for( ::string const& s : rs->soft ) sge_cmd_line.push_back(s) ; }
-			//
+			::vector_s sge_cmd_line = _mk_qsub_cmd_line(
+				repo_key+Job(j)->name()
+			,	se.verbose ? *g_repo_root_s+dir_guard(get_stderr_file(j)) : "/dev/null"s
+			,	_prio(reqs)
+			,	*se.rsrcs
+			) ;
+			sge_cmd_line.emplace_back("-b"    ) ; sge_cmd_line.emplace_back("y") ;
+			sge_cmd_line.emplace_back("-shell") ; sge_cmd_line.emplace_back("n") ;
 			for( ::string const& c : cmd_line ) sge_cmd_line.push_back(c) ;
 			//
-			Trace trace(BeChnl,"Sge::launch_job",repo_key,j,sge_cmd_line,rs) ;
+			Trace trace(BeChnl,"Sge::launch_job",repo_key,j,sge_cmd_line,se.rsrcs) ;
 			//
 			return sge_exec_qsub(::move(sge_cmd_line)) ;
 		}
+		// jobs with identical resources are submitted as a single array
+		void launch_jobs( ::stop_token st , ::vector<LaunchDescr> const& lds ) override {
+			if (!use_arrays) return Base::launch_jobs(st,lds) ;
+			::vector<LaunchDescr>                      singles ;
+			::umap<Rsrcs,::vector<LaunchDescr const*>> groups  ;
+			for( LaunchDescr const& ld : lds ) groups[ld.entry->rsrcs].push_back(&ld) ;
+			for( auto const& [rs,glds] : groups ) {
+				if (glds.size()==1) { singles.push_back(*glds[0]) ; continue ; }                    // no need to create an array of 1 task
+				for( size_t i=0 ; i<glds.size() ; i+=MaxArraySz ) {
+					size_t sz = ::min( MaxArraySz , glds.size()-i ) ;
+					_launch_array( *rs , {&glds[i],sz} ) ;
+				}
+			}
+			if (+singles) Base::launch_jobs(st,singles) ;
+		}
 
 		bool/*ok*/ sge_exec_client(::vector_s&& cmd_line) const {
 			Trace trace(BeChnl,"sge_exec_client",cmd_line) ;
@@ -273,9 +293,10 @@ namespace Backends::Sge {
 			return wstatus_ok(wstatus) ;
 		}
 
-		SgeId sge_exec_qsub(::vector_s&& cmd_line) const {
+		// if script is provided, it is fed to qsub through its stdin
+		SgeId sge_exec_qsub( ::vector_s&& cmd_line , ::string const& script={} ) const {
 			SWEAR( cmd_line[0]=="qsub" && cmd_line[1]=="-terse" ) ;                                             // only meant to accept a short stdout
-			Trace trace(BeChnl,"sge_exec_qsub",cmd_line) ;
+			Trace trace(BeChnl,"sge_exec_qsub",cmd_line,script.size()) ;
 			TraceLock lock { _sge_mutex , BeChnl , "sge_exec_qsub" } ;
 			cmd_line[0] = sge_bin_s+cmd_line[0] ;
 			//
@@ -285,6 +306,12 @@ namespace Backends::Sge {
 				/**/                                cmd_line_[i  ] = nullptr   ;
 			}
 			AcPipe c2p { New , O_NONBLOCK , true/*no_std*/ } ;
+			AcFd   in  ;
+			if (+script) {                                                                                      // use a memory file rather than a pipe so we never block on qsub reading it
+				in = AcFd( ::memfd_create("qsub_script",MFD_CLOEXEC) , true/*no_std*/ ) ; SWEAR_PROD(+in) ;
+				in.write(script) ;
+				::lseek(in,0,SEEK_SET) ;
+			}
 			// calling ::vfork is faster as lmake_server is a heavy process, so walking the page table is a significant perf hit
 			pid_t  pid = ::vfork() ;                                                                            // NOLINT(clang-analyzer-security.insecureAPI.vfork)
 			// NOLINTBEGIN(clang-analyzer-unix.Vfork) allowed in Linux
@@ -293,7 +320,8 @@ namespace Backends::Sge {
 				SWEAR( c2p.read .fd>Fd::Std.fd , c2p.read  ) ;                                                  // ensure we can safely close what needs to be closed
 				SWEAR( c2p.write.fd>Fd::Std.fd , c2p.write ) ;                                                  // .
 				::dup2(c2p.write,Fd::Stdout) ;
-				::close(Fd::Stdin) ;                                                                            // ensure no stdin (defensive programming)
+				if (+in) ::dup2 (in,Fd::Stdin) ;
+				else     ::close(   Fd::Stdin) ;                                                                // ensure no stdin (defensive programming)
 				::close(c2p.read ) ;                                                                            // dont touch c2p object as it is shared with parent
 				::close(c2p.write) ;                                                                            // .
 				::execve( cmd_line_[0] , const_cast<char**>(cmd_line_) , const_cast<char**>(_sge_env.get()) ) ;
@@ -327,7 +355,45 @@ namespace Backends::Sge {
 			if (cmd_out[cnt-1]!='\n'       ) FAIL_PROD("incomplete stdout of" ,cmd_line[0],':',cmd_out.substr(0,cnt)) ;
 			cmd_out.resize(cnt) ;
 			trace("done_cmd_out",cmd_out) ;
-			return from_string<SgeId>(cmd_out) ;
+			// for arrays, output is <id>.<first>-<last>:<step>
+			size_t end_pos ;
+			return from_string<SgeId>( cmd_out , false/*empty_ok*/ , false/*hex*/ , &end_pos ) ;
+		}
+
+		// stdout may be large, so it is redirected to a memory file rather than a pipe
+		::string sge_exec_query(::vector_s&& cmd_line) const {
+			Trace trace(BeChnl,"sge_exec_query",cmd_line) ;
+			TraceLock lock { _sge_mutex , BeChnl , "sge_exec_query" } ;
+			cmd_line[0] = sge_bin_s+cmd_line[0] ;
+			//
+			const char** cmd_line_ = new const char*[cmd_line.size()+1] ;
+			{	size_t i = 0 ;
+				for( ::string const& a : cmd_line ) cmd_line_[i++] = a.c_str() ;
+				/**/                                cmd_line_[i  ] = nullptr   ;
+			}
+			AcFd out { ::memfd_create("qstat_out",MFD_CLOEXEC) , true/*no_std*/ } ; SWEAR_PROD(+out) ;
+			// calling ::vfork is faster as lmake_server is a heavy process, so walking the page table is a significant perf hit
+			pid_t pid = ::vfork() ;                                                                             // NOLINT(clang-analyzer-security.insecureAPI.vfork)
+			// NOLINTBEGIN(clang-analyzer-unix.Vfork) allowed in Linux
+			if (!pid) {                                                                                         // in child
+				// /!\ this section must be malloc free as malloc takes a lock that may be held by another thread at the time process is cloned
+				::dup2(out,Fd::Stdout) ;
+				::close(Fd::Stdin) ;                                                                            // ensure no stdin (defensive programming)
+				::execve( cmd_line_[0] , const_cast<char**>(cmd_line_) , const_cast<char**>(_sge_env.get()) ) ;
+				{ [[maybe_unused]] int rc = ::write( 2 , "cannot exec " , 12                     ) ; }          // NO_COV in case exec fails
+				{ [[maybe_unused]] int rc = ::write( 2 , cmd_line_[0]   , ::strlen(cmd_line_[0]) ) ; }          // NO_COV .
+				{ [[maybe_unused]] int rc = ::write( 2 , "\n"           , 1                      ) ; }          // NO_COV .
+				::_exit(+Rc::System) ;                                                                          // NO_COV .
+			}
+			SWEAR_PROD( pid>0 , pid ) ;
+			// NOLINTEND(clang-analyzer-unix.Vfork) allowed in Linux
+			int wstatus ;
+			int rc      = ::waitpid(pid,&wstatus,0/*options*/) ; swear_prod(rc==pid,"cannot wait for pid",pid) ;
+			delete[] cmd_line_ ;        // safe even if not waiting pid, as thread is suspended by ::vfork until child has exec'ed
+			trace("done_pid",wstatus) ;
+			throw_unless( wstatus_ok(wstatus) , "cannot query SGE daemon" ) ;
+			::lseek(out,0,SEEK_SET) ;
+			return out.read() ;
 		}
 
 		// data
@@ -344,14 +410,122 @@ namespace Backends::Sge {
 		::string           sge_cluster       ;
 		::string           sge_root_s        ;
 		::vmap_ss          env               ;
+		bool               use_arrays        = false ;
 	private :
 		::unique_ptr<const char*[]> _sge_env     ;
 		::vector_s                  _sge_env_vec ;  // hold _sge_env strings of the form key=value
 		Mutex<> mutable             _sge_mutex   ;  // ensure no more than a single outstanding request to daemon
 
+		// snapshot of all queued jobs, taken once per heartbeat round
+		// no need for a mutex as heartbeat functions are called with backend lock held
+		bool mutable                         _job_states_ok = false ;
+		::umap<SgeId,::vmap_s<bool>> mutable _job_states    ;         // for each job, a list of (task ranges,in error state)
+
+		// services
+		int16_t _prio(::vector<ReqIdx> const& reqs) const {
+			SWEAR(+reqs) ;                                                                                     // why launch a job if for no req ?
+			return ::max<int16_t>( reqs , [&](ReqIdx r) { return req_prios[r] ; } , Min<int16_t> ) ;
+		}
+		::vector_s _mk_qsub_cmd_line( ::string const& name , ::string const& stderr_file , int16_t prio , RsrcsData const& rs ) const {
+			::vector_s res = {
+				"qsub"
+			,	"-terse"
+			,	"-o"     , "/dev/null"
+			,	"-e"     , stderr_file
+			,	"-N"     , sge_mk_name(::copy(name))
+			} ;
+			if (+env) {
+				::string env_str ;
+				First    first   ;
+				for( auto const& [k,v] : env ) env_str <<first("",",")<< k <<'='<< v ;
+				res.emplace_back("-v"   ) ;
+				res.emplace_back(env_str) ;
+			}
+			if ( prio                )           { res.emplace_back("-p"   ) ; res.push_back(               to_string(prio   )) ;   }
+			if ( +cpu_rsrc && rs.cpu )           { res.emplace_back("-l"   ) ; res.push_back(cpu_rsrc+'='+::to_string(rs.cpu )) ;   }
+			if ( +mem_rsrc && rs.mem )           { res.emplace_back("-l"   ) ; res.push_back(mem_rsrc+'='+::to_string(rs.mem )) ;   }
+			if ( +tmp_rsrc && rs.tmp )           { res.emplace_back("-l"   ) ; res.push_back(tmp_rsrc+'='+::to_string(rs.tmp )) ;   }
+			for( auto const& [k,v] : rs.tokens ) { res.emplace_back("-l"   ) ; res.push_back(k       +'='+::to_string(v      )) ;   }
+			if ( +rs.hard            )           {                             for( ::string const& s : rs.hard ) res.push_back(s) ; }
+			if ( +rs.soft            )           { res.emplace_back("-soft") ; for( ::string const& s : rs.soft ) res.push_back(s) ; }
+			return res ;
+		}
+		void _launch_array( RsrcsData const& rs , ::span<LaunchDescr const* const> lds ) {
+			::string script = "case $SGE_TASK_ID in\n" ;
+			int16_t  prio   = Min<int16_t>              ;
+			for( size_t i : iota(lds.size()) ) {
+				LaunchDescr const& ld = *lds[i] ;
+				script << i+1 <<')' ;
+				for( ::string const& c : ld.cmd_line ) script <<' '<< mk_shell_str(c) ;
+				if (ld.entry->verbose) script <<" 2>"<< mk_shell_str(*g_repo_root_s+dir_guard(get_stderr_file(ld.job))) ;
+				script << " ;;\n" ;
+				prio = ::max( prio , _prio(ld.reqs) ) ;                                                        // array is as urgent as its most urgent task
+			}
+			script << "esac\n" ;
+			::vector_s sge_cmd_line = _mk_qsub_cmd_line( cat(repo_key,lds.size()," jobs") , "/dev/null" , prio , rs ) ;
+			sge_cmd_line.emplace_back("-S") ; sge_cmd_line.emplace_back("/bin/sh"              ) ;
+			sge_cmd_line.emplace_back("-t") ; sge_cmd_line.emplace_back(cat("1-",lds.size())) ;
+			Trace trace(BeChnl,"Sge::launch_array",repo_key,lds.size(),prio,rs) ;
+			try {
+				SgeId id = sge_exec_qsub( ::move(sge_cmd_line) , script ) ;
+				trace("child",id) ;
+				for( uint32_t i : iota(lds.size()) ) launched( *lds[i] , sge_mk_spawn_id(id,i+1) ) ;
+			} catch (::string const& e) {
+				trace("fail",e) ;
+				for( LaunchDescr const* ld : lds ) launched( *ld , e ) ;
+			}
+		}
+		void _refresh_job_states() const {
+			Trace trace(BeChnl,"Sge::refresh_job_states") ;
+			_job_states.clear() ;
+			_job_states_ok = true ;                                                                            // even in case of error, so as to not retry for each job
+			::string out ;
+			try                       { out = sge_exec_query({"qstat","-xml"}) ; }
+			catch (::string const& e) { trace("cannot_query",e) ; return ;      }                              // jobs will be queried individually
+			auto field = [&]( size_t start , size_t end , ::string const& tag )->::string {
+				size_t p = out.find(cat('<' ,tag,'>'),start) ; if (p>=end) return {} ;
+				/**/   p += tag.size()+2                     ;
+				size_t q = out.find(cat("</",tag,'>'),p    ) ; if (q>=end) return {} ;
+				return out.substr(p,q-p) ;
+			} ;
+			for( size_t start=out.find("<job_list") ; start!=Npos ; start=out.find("<job_list",start) ) {
+				size_t   end    = out.find("</job_list>",start)                  ; if (end==Npos) break ;
+				::string id_str = field(start,end,"JB_job_number")                 ;
+				::string tasks  = field(start,end,"tasks"        )                 ;
+				bool     err    = field(start,end,"state"        ).find('E')!=Npos ;                           // E in state means error (e.g. Eqw)
+				start = end ;
+				try                     { _job_states[from_string<SgeId>(id_str)].emplace_back(tasks,err) ; }
+				catch (::string const&) {                                                                    } // ignore garbage
+			}
+			trace("done",_job_states.size()) ;
+		}
+		// Yes means alive, No means in error state, Maybe means not found in snapshot
+		Bool3 _job_state(SpawnId sid) const {
+			auto it = _job_states.find(sge_spawn_job(sid)) ; if (it==_job_states.end()) return Maybe ;
+			uint32_t task = sge_spawn_task(sid) ;
+			for( auto const& [tasks,err] : it->second )
+				if (_in_tasks(tasks,task)) return err ? No : Yes ;
+			return Maybe ;
+		}
+		// tasks is of the form 1,3-5,7-11:2
+		static bool _in_tasks( ::string const& tasks , uint32_t task ) {
+			if ( !task || !tasks ) return true ;                                                               // not an array task or no info
+			try {
+				for( ::string const& r : split(tasks,',') ) {
+					size_t   dash  = r.find('-')                            ;
+					uint32_t first = from_string<uint32_t>(r.substr(0,dash)) ;
+					if (dash==Npos) { if (task==first) return true ; continue ; }
+					size_t   colon = r.find(':',dash)                                           ;
+					uint32_t last  = from_string<uint32_t>(r.substr(dash+1,colon-dash-1))      ;
+					uint32_t step  = colon==Npos ? 1 : from_string<uint32_t>(r.substr(colon+1)) ;
+					if ( task>=first && task<=last && (task-first)%step==0 ) return true ;
+				}
+				return false ;
+			} catch (::string const&) { return true ; }                                                        // cannot parse, assume task is in
+		}
 	} ;
 
-	QueueThread<::pair<SgeBackend const*,SgeId>> SgeBackend::_s_sge_cancel_thread ;
+	QueueThread<::pair<SgeBackend const*,SpawnId>> SgeBackend::_s_sge_cancel_thread ;
 
 	//
 	// init
@@ -448,8 +622,10 @@ namespace Backends::Sge {
 	}
 
 
-	void sge_cancel(::pair<SgeBackend const*,SgeId> const& info) {
-		info.first->sge_exec_client({"qdel",to_string(info.second)}) ; // if error, job is most certainly already dead, nothing to do
+	void sge_cancel(::pair<SgeBackend const*,SpawnId> const& info) {
+		::vector_s cmd_line = { "qdel" , to_string(sge_spawn_job(info.second)) } ;
+		if ( uint32_t task=sge_spawn_task(info.second) ) { cmd_line.emplace_back("-t") ; cmd_line.push_back(to_string(task)) ; } // only delete our task if job is an array
+		info.first->sge_exec_client(::move(cmd_line)) ;                                                                          // if error, job is most certainly already dead, nothing to do
 	}
 
 	::string sge_mk_name(::string&& s) {
@@ -43,8 +43,20 @@ namespace Backends::Slurm {
 		,	Delay                   timeout
 		,	bool                    verbose
 		) = nullptr ;
-		::pair_s<Bool3/*job_ok*/> (*job_state_func)(SlurmId) = nullptr ;
-		void                      (*cancel_func   )(SlurmId) = nullptr ;
+		SlurmId (*spawn_array_func)(
+			::stop_token               st
+		,	::string            const& key
+		,	::vector<ArrayTask> const& tasks
+		,	::vector<ReqIdx>    const& reqs
+		,	int32_t                    nice
+		,	const char**               env
+		,	RsrcsData           const& rsrcs
+		,	Delay                      timeout
+		) = nullptr ;
+		::pair_s<Bool3/*job_ok*/> (*job_state_func       )(SpawnId) = nullptr ;
+		::pair_s<Bool3/*job_ok*/> (*bulk_job_state_func  )(SpawnId) = nullptr ;
+		void                      (*flush_job_states_func)(       ) = nullptr ;
+		void                      (*cancel_func          )(SpawnId) = nullptr ;
 	}
 
 	//
@@ -78,7 +90,8 @@ namespace Backends::Slurm {
 	,	bool                    verbose
 	) ;
 
-	constexpr Tag MyTag = Tag::Slurm ;
+	constexpr Tag    MyTag      = Tag::Slurm ;
+	constexpr size_t MaxArraySz = 1000       ; // slurm default for MaxArraySize is 1001
 
 	struct SlurmBackend
 	:	             GenericBackend<MyTag,'U'/*LaunchThreadKey*/,RsrcsData>
@@ -108,7 +121,7 @@ namespace Backends::Slurm {
 		}
 
 		// static data
-		static QueueThread<SlurmId> _s_slurm_cancel_thread ; // when a req is killed, a lot of queued jobs may be canceled, better to do it in a separate thread
+		static QueueThread<SpawnId> _s_slurm_cancel_thread ; // when a req is killed, a lot of queued jobs may be canceled, better to do it in a separate thread
 
 		// accesses
 
@@ -130,7 +143,8 @@ namespace Backends::Slurm {
 						/**/       if (k=="licenses"         ) { licenses          =                             v   ; continue ; } break ;
 						case 'n' : if (k=="n_max_queued_jobs") { n_max_queued_jobs =       from_string<uint32_t>(v)  ; continue ; } break ;
 						case 'r' : if (k=="repo_key"         ) { repo_key          =                             v   ; continue ; } break ;
-						case 'u' : if (k=="use_nice"         ) { use_nice          =       from_string<bool    >(v)  ; continue ; } break ;
+						case 'u' : if (k=="use_arrays"       ) { use_arrays        =       from_string<bool    >(v)  ; continue ; }
+						/**/       if (k=="use_nice"         ) { use_nice          =       from_string<bool    >(v)  ; continue ; } break ;
 					DN}
 				} catch (::string const& e) { trace("bad_val",k,v) ; throw cat("wrong value for entry "    ,k+": ",v) ; }
 				/**/                        { trace("bad_key",k  ) ; throw cat("unexpected config entry : ",k       ) ; }
@@ -159,6 +173,7 @@ namespace Backends::Slurm {
 			if (+init_timeout     ) descr_map.emplace_back( "init_timeout"      ,     init_timeout     .short_str() ) ;
 			if (+n_max_queued_jobs) descr_map.emplace_back( "n_max_queued_jobs" , cat(n_max_queued_jobs)            ) ;
 			if (+repo_key         ) descr_map.emplace_back( "repo_key"          ,     repo_key                      ) ;
+			if ( use_arrays       ) descr_map.emplace_back( "use_arrays"        , cat(use_arrays)                   ) ;
 			/**/                    descr_map.emplace_back( "manage_mem"        , cat(daemon.manage_mem)            ) ;
 			{	size_t w = ::max<size_t>( descr_map , [](::pair_ss const& k_v) { return k_v.first.size() ; } ) ;
 				for( auto const& [k,v] : descr_map ) descr << widen(k,w)<<" : "<<v<<'\n' ;
@@ -236,7 +251,7 @@ namespace Backends::Slurm {
 		}
 		::string start_job( Job , SpawnedEntry const& se ) const override {
 			SWEAR(+se.rsrcs) ;
-			return cat("slurm_id:",se.id.load()) ;
+			return cat("slurm_id:",spawn_id_str(se.id)) ;
 		}
 		::pair_s<bool/*retry*/> end_job( Job j , SpawnedEntry const& se , Status s ) const override {
 			if ( !se.verbose && s==Status::Ok ) return {{}/*msg*/,true/*retry*/} ;                    // common case, must be fast, if job is in error, better to ask slurm why, e.g. could be OOM
@@ -261,8 +276,15 @@ namespace Backends::Slurm {
 			}
 			return { info.first , info.second!=No } ;
 		}
+		void heartbeat() override {
+			Base::heartbeat() ;
+			// called once per heartbeat round, take a new snapshot for next round
+			// heartbeat may be called before backend is configured, while slurm is not loaded yet
+			if (SlurmApi::flush_job_states_func) SlurmApi::flush_job_states_func() ;
+		}
 		::pair_s<HeartbeatState> heartbeat_queued_job( Job j , SpawnedEntry const& se ) const override {
-			::pair_s<Bool3/*job_ok*/> info = SlurmApi::job_state_func(se.id) ;
+			// a single request to slurm daemon for all queued jobs
+			::pair_s<Bool3/*job_ok*/> info = SlurmApi::bulk_job_state_func(se.id) ;
 			if (info.second==Maybe) return {{}/*msg*/,HeartbeatState::Alive} ;
 			//
 			if ( se.verbose && +info.first ) {     // /!\ only read stderr when something to say as what appears to be a filesystem bug (seen with ceph) sometimes blocks !
@@ -275,13 +297,34 @@ namespace Backends::Slurm {
 		void kill_queued_job(SpawnedEntry const& se) const override {
 			if (!se.zombie) _s_slurm_cancel_thread.push(se.id) ;                                        // asynchronous (as faster and no return value) cancel
 		}
-		SpawnId launch_job( ::stop_token st , Job j , ::vector<ReqIdx> const& reqs , Pdate prio , ::vector_s const& cmd_line , SpawnedEntry const& se ) const override {
+		int32_t _nice(Pdate prio) const {
 			int32_t nice = use_nice ? int32_t((prio-daemon.time_origin).sec()*daemon.nice_factor) : 0 ;
-			nice &= 0x7fffffff ;                                                                        // slurm will not accept negative values, default values overflow in ... 2091
-			SlurmId id = SlurmApi::spawn_job_func( st , repo_key , j , reqs , nice , cmd_line , _slurm_env.get() , *se.rsrcs , se.timeout , se.verbose ) ;
+			return nice & 0x7fffffff ;                                                                  // slurm will not accept negative values, default values overflow in ... 2091
+		}
+		SpawnId launch_job( ::stop_token st , Job j , ::vector<ReqIdx> const& reqs , Pdate prio , ::vector_s const& cmd_line , SpawnedEntry const& se ) const override {
+			int32_t nice = _nice(prio) ;
+			SlurmId id   = SlurmApi::spawn_job_func( st , repo_key , j , reqs , nice , cmd_line , _slurm_env.get() , *se.rsrcs , se.timeout , se.verbose ) ;
 			Trace trace(BeChnl,"Slurm::launch_job",repo_key,j,id,nice,cmd_line,se.rsrcs,STR(se.verbose)) ;
 			return id ;
 		}
+		// jobs with identical rounded resources are submitted as a single array, using these resources
+		void launch_jobs( ::stop_token st , ::vector<LaunchDescr> const& lds ) override {
+			if (!use_arrays) return Base::launch_jobs(st,lds) ;
+			::vector<LaunchDescr>                      singles ;
+			::umap<Rsrcs,::vector<LaunchDescr const*>> groups  ;
+			// heterogeneous jobs cannot be arrays and there is no need to create an array of 1 task
+			for( LaunchDescr const& ld : lds )
+				if (ld.entry->rounded_rsrcs->size()>1) singles.push_back(ld)                          ;
+				else                                   groups[ld.entry->rounded_rsrcs].push_back(&ld) ;
+			for( auto const& [rrs,glds] : groups ) {
+				if (glds.size()==1) { singles.push_back(*glds[0]) ; continue ; }
+				for( size_t i=0 ; i<glds.size() ; i+=MaxArraySz ) {
+					size_t sz = ::min( MaxArraySz , glds.size()-i ) ;
+					_launch_array( st , *rrs , {&glds[i],sz} ) ;
+				}
+			}
+			if (+singles) Base::launch_jobs(st,singles) ;
+		}
 
 		// data
 		SpawnedMap mutable  spawned_rsrcs     ;                 // number of spawned jobs queued in slurm queue
@@ -291,14 +334,39 @@ namespace Backends::Slurm {
 		uint32_t            n_max_queued_jobs = 10            ; // by default, limit to 10 the number of jobs waiting for a given set of resources
 		Delay               init_timeout      = Delay(10)     ;
 		bool                use_nice          = false         ;
+		bool                use_arrays        = false         ; // if true, jobs with identical rounded resources are submitted as arrays
 		::string            repo_key          ;                 // a short identifier of the repository
 		Daemon              daemon            ;                 // info sensed from slurm daemon
 	private :
 		::unique_ptr<const char*[]> _slurm_env     ;
 		::vector_s                  _slurm_env_vec ;
+
+		// services
+		void _launch_array( ::stop_token st , RsrcsData const& rsrcs , ::span<LaunchDescr const* const> lds ) {
+			::vector<ArrayTask> tasks   ; tasks.reserve(lds.size()) ;
+			::uset<ReqIdx>      reqs    ;
+			int32_t             nice    = 0x7fffffff ;
+			Delay               timeout = lds[0]->entry->timeout ;
+			for( LaunchDescr const* ld : lds ) {
+				Delay to = ld->entry->timeout ;
+				tasks.push_back({ ld->job , &ld->cmd_line , ld->entry->verbose }) ;
+				for( ReqIdx r : ld->reqs ) reqs.insert(r) ;
+				nice = ::min( nice , _nice(ld->prio) ) ;                // array is as urgent as its most urgent task
+				if ( +timeout && ( !to || to>timeout ) ) timeout = to ; // no timeout is larger than any timeout
+			}
+			Trace trace(BeChnl,"Slurm::launch_array",repo_key,lds.size(),nice,rsrcs) ;
+			try {
+				SlurmId id = SlurmApi::spawn_array_func( st , repo_key , tasks , mk_vector(reqs) , nice , _slurm_env.get() , rsrcs , timeout ) ;
+				trace("child",id) ;
+				for( uint32_t i : iota(lds.size()) ) launched( *lds[i] , mk_spawn_id(id,i) ) ;
+			} catch (::string const& e) {
+				trace("fail",e) ;
+				for( LaunchDescr const* ld : lds ) launched( *ld , e ) ;
+			}
+		}
 	} ;
 
-	QueueThread<SlurmId> SlurmBackend::_s_slurm_cancel_thread ;
+	QueueThread<SpawnId> SlurmBackend::_s_slurm_cancel_thread ;
 
 	//
 	// init
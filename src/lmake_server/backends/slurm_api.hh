@@ -64,6 +64,22 @@ namespace Backends::Slurm {
 	} ;
 
 	extern Mutex<> slurm_mutex ; // ensure no more than a single outstanding request to daemon
+
+	// array tasks are identified by their array job id and task index, both encoded in a single SpawnId
+	static constexpr uint32_t NoTask = -1 ;
+	inline SpawnId  mk_spawn_id ( SlurmId job , uint32_t task=NoTask ) { return SpawnId(uint32_t(task+1))<<32 | job ; }
+	inline SlurmId  spawn_job   ( SpawnId id                         ) { return SlurmId(id)                        ; }
+	inline uint32_t spawn_task  ( SpawnId id                         ) { return uint32_t(id>>32)-1                 ; } // NoTask if not an array task
+	inline ::string spawn_id_str( SpawnId id                         ) {
+		if (spawn_task(id)==NoTask) return cat(spawn_job(id)                   ) ;
+		else                        return cat(spawn_job(id),'_',spawn_task(id)) ;                                     // slurm syntax
+	}
+
+	struct ArrayTask {
+		Job               job      ;
+		::vector_s const* cmd_line = nullptr ;
+		bool              verbose  = false   ;
+	} ;
 }
 
 namespace Backends::Slurm::SlurmApi {
@@ -88,8 +104,20 @@ namespace Backends::Slurm::SlurmApi {
 	,	Time::Delay             timeout
 	,	bool                    verbose
 	) ;
-	extern ::pair_s<Bool3/*job_ok*/> (*job_state_func)(SlurmId) ;                // Maybe means job has not completed
-	extern void                      (*cancel_func   )(SlurmId) ;
+	extern SlurmId (*spawn_array_func)(
+		::stop_token               st
+	,	::string            const& key
+	,	::vector<ArrayTask> const& tasks
+	,	::vector<ReqIdx>    const& reqs
+	,	int32_t                    nice
+	,	const char**               env
+	,	RsrcsData           const& rsrcs
+	,	Time::Delay                timeout
+	) ;
+	extern ::pair_s<Bool3/*job_ok*/> (*job_state_func       )(SpawnId) ;         // Maybe means job has not completed
+	extern ::pair_s<Bool3/*job_ok*/> (*bulk_job_state_func  )(SpawnId) ;         // same, but use a snapshot of all jobs taken with a single request
+	extern void                      (*flush_job_states_func)(       ) ;         // next call to bulk_job_state_func will take a new snapshot
+	extern void                      (*cancel_func          )(SpawnId) ;
 
 	inline ::string version_str(long v) {
 		int major = (v>>16)&0xff ;
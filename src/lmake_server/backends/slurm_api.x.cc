@@ -30,10 +30,12 @@ namespace Backends::Slurm::SlurmApi {
 	static decltype(slurm_free_submit_response_response_msg)* _free_submit_response_response_msg = nullptr/*garbage*/ ;
 	static decltype(slurm_init_job_desc_msg                )* _init_job_desc_msg                 = nullptr/*garbage*/ ;
 	static decltype(slurm_kill_job                         )* _kill_job                          = nullptr/*garbage*/ ;
+	static decltype(slurm_kill_job2                        )* _kill_job2                         = nullptr/*garbage*/ ;
 	static decltype(slurm_list_append                      )* _list_append                       = nullptr/*garbage*/ ;
 	static decltype(slurm_list_create                      )* _list_create                       = nullptr/*garbage*/ ;
 	static decltype(slurm_list_destroy                     )* _list_destroy                      = nullptr/*garbage*/ ;
 	static decltype(slurm_load_job                         )* _load_job                          = nullptr/*garbage*/ ;
+	static decltype(slurm_load_job_user                    )* _load_job_user                     = nullptr/*garbage*/ ;
 	static decltype(slurm_strerror                         )* _strerror                          = nullptr/*garbage*/ ;
 	static decltype(slurm_submit_batch_het_job             )* _submit_batch_het_job              = nullptr/*garbage*/ ;
 	static decltype(slurm_submit_batch_job                 )* _submit_batch_job                  = nullptr/*garbage*/ ;
@@ -45,71 +47,54 @@ namespace Backends::Slurm::SlurmApi {
 		res += '\n' ;
 		return res ;
 	}
-	static SlurmId _spawn_job(
-		::stop_token            st
-	,	::string         const& key
-	,	Job                     job
-	,	::vector<ReqIdx> const& reqs
-	,	int32_t                 nice
-	,	::vector_s       const& cmd_line
+	static void _fill_job_desc(
+		job_desc_msg_t        & j                                                                                  // out
+	,	::string              & gres                                                                               // out, must be kept alive until job is submitted
+	,	RsrcsDataSingle  const& r
+	,	uint32_t                het_job_offset
+	,	::string         const& name
+	,	::string         const& comment
 	,	const char**            env
-	,	RsrcsData        const& rsrcs
+	,	int32_t                 nice
+	,	char*                   script                                                                             // only for first component
+	,	char*                   std_err
 	,	Delay                   timeout
-	,	bool                    verbose
 	) {
 		static ::string repo_root = no_slash(*g_repo_root_s) ;
-		Trace trace(BeChnl,"slurm_spawn_job",key,job,nice,cmd_line,rsrcs,STR(verbose)) ;
 		//
-		SWEAR     ( rsrcs.size()> 0        ) ;
-		SWEAR_PROD( nice        >=0 , nice ) ;
-		// first element is treated specially to avoid allocation in the very frequent case of a single element
-		::string                 job_name       = job->name()              ;
-		::string                 key_job_name   = key + job_name           ;
-		::string                 comment        ;                            if (key_job_name.size()>256) comment = ::move(job_name) ;
-		::string                 script         = _cmd_to_string(cmd_line) ;
-		::string                 stderr_file    ;                            if(verbose) dir_guard(stderr_file=get_stderr_file(job)) ; //                 keep alive until slurm is called
-		job_desc_msg_t           job_desc0      ;                                                                                      // first element   .
-		::string                 gres0          ;                                                                                      // .             , .
-		::vector<job_desc_msg_t> job_descs      ;                            if (rsrcs.size()>1) job_descs.reserve(rsrcs.size()-1) ;   // other elements  .
-		::vector_s               gress          ;                            if (rsrcs.size()>1) gress    .reserve(rsrcs.size()-1) ;   // .             , .
-		uint32_t                 het_job_offset = 0                        ;
-		for( bool first=true ; RsrcsDataSingle const& r : rsrcs ) {
-			//                           first element other elements
-			job_desc_msg_t& j    = first ? job_desc0 : job_descs.emplace_back() ;                                                      // keep alive
-			::string      & gres = first ? gres0     : gress    .emplace_back() ;                                                      // .
-			//
-			gres = "gres:"+r.gres ;
-			//
-			_init_job_desc_msg(&j) ;
-			SWEAR( timeout>=Delay() , timeout ) ;
-			/**/                     j.comment         = const_cast<char*>(comment.c_str())                            ;
-			/**/                     j.cpus_per_task   = r.cpu                                                         ;
-			/**/                     j.environment     = const_cast<char**>(env)                                       ;               // terminated with an empty string
-			/**/                     j.env_size        = 1                                                             ;               // seems to only work when 1
-			if (+r.excludes        ) j.exc_nodes       = const_cast<char*>(r.excludes .data())                         ;
-			if (+r.features        ) j.features        = const_cast<char*>(r.features .data())                         ;
-			/**/                     j.het_job_offset  = het_job_offset++                                              ;               // seems to only work when 1
-			if (+r.licenses        ) j.licenses        = const_cast<char*>(r.licenses .data())                         ;
-			/**/                     j.max_cpus        = r.cpu                                                         ;               // by symmetry with min_cpus
-			/**/                     j.min_cpus        = r.cpu                                                         ;               // version >25.05 requires this
-			/**/                     j.name            = const_cast<char*>(key_job_name.c_str())                       ;
-			/**/                     j.nice            = NICE_OFFSET+nice                                              ;
-			/**/                     j.num_tasks       = 1                                                             ;               // version 25.11 requires this (after gemini recommandation)
-			if (+r.partition       ) j.partition       = const_cast<char*>(r.partition.data())                         ;
-			/**/                     j.pn_min_memory   = r.mem                                                         ;               //in MB
-			if (r.tmp!=uint32_t(-1)) j.pn_min_tmp_disk = r.tmp                                                         ;               //in MB
-			if (+r.qos             ) j.qos             = const_cast<char*>(r.qos      .data())                         ;
-			if (+r.nodes           ) j.req_nodes       = const_cast<char*>(r.nodes    .data())                         ;
-			if (+r.reserv          ) j.reservation     = const_cast<char*>(r.reserv   .data())                         ;
-			if (first              ) j.script          =                   script     .data()                          ;
-			/**/                     j.std_err         = verbose ? stderr_file.data() : const_cast<char*>("/dev/null") ;
-			/**/                     j.std_out         =                                const_cast<char*>("/dev/null") ;
-			if (+timeout           ) j.time_limit      = div_up<60>(::make_unsigned_t<Delay::Tick>(timeout.sec()))+1   ;               // take some margin so actual timeout occurs in job
-			if (+r.gres            ) j.tres_per_node   =                   gres       .data()                          ;
-			if (+r.wckey           ) j.wckey           = const_cast<char*>(r.wckey    .data())                         ;
-			/**/                     j.work_dir        = repo_root.data()                                              ;
-			first =false ;
-		}
+		gres = "gres:"+r.gres ;
+		//
+		_init_job_desc_msg(&j) ;
+		SWEAR( timeout>=Delay() , timeout ) ;
+		/**/                     j.comment         = const_cast<char*>(comment.c_str())                          ;
+		/**/                     j.cpus_per_task   = r.cpu                                                       ;
+		/**/                     j.environment     = const_cast<char**>(env)                                     ; // terminated with an empty string
+		/**/                     j.env_size        = 1                                                           ; // seems to only work when 1
+		if (+r.excludes        ) j.exc_nodes       = const_cast<char*>(r.excludes .data())                       ;
+		if (+r.features        ) j.features        = const_cast<char*>(r.features .data())                       ;
+		/**/                     j.het_job_offset  = het_job_offset                                              ; // seems to only work when 1
+		if (+r.licenses        ) j.licenses        = const_cast<char*>(r.licenses .data())                       ;
+		/**/                     j.max_cpus        = r.cpu                                                       ; // by symmetry with min_cpus
+		/**/                     j.min_cpus        = r.cpu                                                       ; // version >25.05 requires this
+		/**/                     j.name            = const_cast<char*>(name.c_str())                             ;
+		/**/                     j.nice            = NICE_OFFSET+nice                                            ;
+		/**/                     j.num_tasks       = 1                                                           ; // version 25.11 requires this (after gemini recommandation)
+		if (+r.partition       ) j.partition       = const_cast<char*>(r.partition.data())                       ;
+		/**/                     j.pn_min_memory   = r.mem                                                       ; //in MB
+		if (r.tmp!=uint32_t(-1)) j.pn_min_tmp_disk = r.tmp                                                       ; //in MB
+		if (+r.qos             ) j.qos             = const_cast<char*>(r.qos      .data())                       ;
+		if (+r.nodes           ) j.req_nodes       = const_cast<char*>(r.nodes    .data())                       ;
+		if (+r.reserv          ) j.reservation     = const_cast<char*>(r.reserv   .data())                       ;
+		if (script             ) j.script          = script                                                      ;
+		/**/                     j.std_err         = std_err                                                     ;
+		/**/                     j.std_out         = const_cast<char*>("/dev/null")                              ;
+		if (+timeout           ) j.time_limit      = div_up<60>(::make_unsigned_t<Delay::Tick>(timeout.sec()))+1 ; // take some margin so actual timeout occurs in job
+		if (+r.gres            ) j.tres_per_node   = gres.data()                                                 ;
+		if (+r.wckey           ) j.wckey           = const_cast<char*>(r.wckey    .data())                       ;
+		/**/                     j.work_dir        = repo_root.data()                                            ;
+	}
+	static SlurmId _submit( ::stop_token st , ::vector<ReqIdx> const& reqs , job_desc_msg_t& job_desc0 , ::vector<job_desc_msg_t>& job_descs , RsrcsData const& rsrcs ) {
+		Trace trace(BeChnl,"slurm_submit",job_descs.size()+1) ;
 		for( int i=0 ; i<SlurmSpawnTrials ; i++ ) {
 			submit_response_msg_t* resp = nullptr/*garbage*/ ;
 			bool                   err  = false  /*garbage*/ ;
@@ -179,10 +164,142 @@ namespace Backends::Slurm::SlurmApi {
 		trace("cannot_spawn") ;
 		throw "cannot connect to slurm daemon"s ;
 	}
+	static SlurmId _spawn_job(
+		::stop_token            st
+	,	::string         const& key
+	,	Job                     job
+	,	::vector<ReqIdx> const& reqs
+	,	int32_t                 nice
+	,	::vector_s       const& cmd_line
+	,	const char**            env
+	,	RsrcsData        const& rsrcs
+	,	Delay                   timeout
+	,	bool                    verbose
+	) {
+		Trace trace(BeChnl,"slurm_spawn_job",key,job,nice,cmd_line,rsrcs,STR(verbose)) ;
+		//
+		SWEAR     ( rsrcs.size()> 0        ) ;
+		SWEAR_PROD( nice        >=0 , nice ) ;
+		// first element is treated specially to avoid allocation in the very frequent case of a single element
+		::string                 job_name       = job->name()              ;
+		::string                 key_job_name   = key + job_name           ;
+		::string                 comment        ;                            if (key_job_name.size()>256) comment = ::move(job_name) ;
+		::string                 script         = _cmd_to_string(cmd_line) ;
+		::string                 stderr_file    ;                            if(verbose) dir_guard(stderr_file=get_stderr_file(job)) ; //                 keep alive until slurm is called
+		char*                    std_err        = verbose ? stderr_file.data() : const_cast<char*>("/dev/null") ;
+		job_desc_msg_t           job_desc0      ;                                                                                      // first element   .
+		::string                 gres0          ;                                                                                      // .             , .
+		::vector<job_desc_msg_t> job_descs      ;                            if (rsrcs.size()>1) job_descs.reserve(rsrcs.size()-1) ;   // other elements  .
+		::vector_s               gress          ;                            if (rsrcs.size()>1) gress    .reserve(rsrcs.size()-1) ;   // .             , .
+		uint32_t                 het_job_offset = 0                        ;
+		for( bool first=true ; RsrcsDataSingle const& r : rsrcs ) {
+			//                           first element other elements
+			job_desc_msg_t& j    = first ? job_desc0 : job_descs.emplace_back() ;                                                                       // keep alive
+			::string      & gres = first ? gres0     : gress    .emplace_back() ;                                                                       // .
+			_fill_job_desc( j , gres , r , het_job_offset++ , key_job_name , comment , env , nice , first?script.data():nullptr , std_err , timeout ) ;
+			first = false ;
+		}
+		return _submit( st , reqs , job_desc0 , job_descs , rsrcs ) ;
+	}
+	// all tasks share the same resources, nice value and timeout, SLURM_ARRAY_TASK_ID selects the command line to run
+	static SlurmId _spawn_array(
+		::stop_token               st
+	,	::string            const& key
+	,	::vector<ArrayTask> const& tasks
+	,	::vector<ReqIdx>    const& reqs
+	,	int32_t                    nice
+	,	const char**               env
+	,	RsrcsData           const& rsrcs
+	,	Delay                      timeout
+	) {
+		Trace trace(BeChnl,"slurm_spawn_array",key,tasks.size(),nice,rsrcs) ;
+		//
+		SWEAR     ( rsrcs.size()==1 , rsrcs.size() ) ;                                                                                                  // heterogeneous jobs cannot be arrays
+		SWEAR_PROD( nice        >=0 , nice         ) ;
+		::string                 key_job_name = cat(key,tasks.size()," jobs")  ;
+		::string                 script       = "#!/bin/sh\ncase $SLURM_ARRAY_TASK_ID in\n" ;
+		::string                 array_inx    = cat("0-",tasks.size()-1)       ;
+		job_desc_msg_t           job_desc     ;
+		::string                 gres         ;
+		::vector<job_desc_msg_t> no_descs     ;
+		for( size_t i : iota(tasks.size()) ) {
+			ArrayTask const& t = tasks[i] ;
+			/**/                                    script << i<<')'                                                         ;
+			for( ::string const& a : *t.cmd_line  ) script <<' '<< mk_shell_str(a)                                           ;
+			if (t.verbose                         ) script <<" 2>"<< mk_shell_str(dir_guard(get_stderr_file(t.job)))         ;                          // per task stderr cannot be provided to slurm
+			/**/                                    script <<" ;;\n"                                                         ;
+		}
+		script += "esac\n" ;
+		_fill_job_desc( job_desc , gres , rsrcs[0] , 0/*het_job_offset*/ , key_job_name , {}/*comment*/ , env , nice , script.data() , const_cast<char*>("/dev/null") , timeout ) ;
+		job_desc.array_inx = array_inx.data() ;
+		return _submit( st , reqs , job_desc , no_descs , rsrcs ) ;
+	}
+
+	struct _JobState {
+		::string msg  ;
+		Bool3    ok   = Yes   ;                                                          // Maybe means job has not completed
+		bool     done = false ;                                                          // if true, job has failed and msg & ok are final
+	} ;
+	// combine info from a record into js, a job is complete when all its records (e.g. components of an heterogeneous job) are complete
+	static void _merge_job_state( _JobState& js/*inout*/ , slurm_job_info_t const& ji ) {
+		if (js.done) return ;
+		job_states s = job_states( ji.job_state & JOB_STATE_BASE ) ;
+		switch (s) {
+			// if slurm sees job failure, somthing weird occurred (if actual job fails, job_exec reports an error and completes successfully)
+			// possible job_states values (from slurm.h) :
+			case JOB_PENDING   :                                js.ok = Maybe ; return ; // queued waiting for initiation
+			case JOB_RUNNING   :                                js.ok = Maybe ; return ; // allocated resources and executing
+			case JOB_SUSPENDED :                                js.ok = Maybe ; return ; // allocated resources, execution suspended
+			case JOB_COMPLETE  :                                                return ; // completed execution successfully
+			case JOB_CANCELLED : js.msg = "cancelled by user" ; js.ok = Yes   ; break  ; // cancelled by user
+			case JOB_TIMEOUT   : js.msg = "timeout"           ; js.ok = No    ; break  ; // terminated on reaching time limit
+			case JOB_NODE_FAIL : js.msg = "node failure"      ; js.ok = Yes   ; break  ; // terminated on node failure
+			case JOB_PREEMPTED : js.msg = "preempted"         ; js.ok = Yes   ; break  ; // terminated due to preemption
+			case JOB_BOOT_FAIL : js.msg = "boot failure"      ; js.ok = Yes   ; break  ; // terminated due to node boot failure
+			case JOB_DEADLINE  : js.msg = "deadline reached"  ; js.ok = Yes   ; break  ; // terminated on deadline
+			case JOB_OOM       : js.msg = "out of memory"     ; js.ok = No    ; break  ; // experienced out of memory error
+			case JOB_FAILED :                                                            // completed execution unsuccessfully
+				// when job_exec receives a signal, the bash process which launches it (which the process seen by slurm) exits with an exit code > 128
+				// however, the user is interested in the received signal, not mapped bash exit code, so undo mapping
+				// signaled wstatus are barely the signal number
+				/**/                                     js.msg = "failed ("                                                                                       ;
+				if      ( WIFSIGNALED(ji.exit_code)     ) js.msg << "signal " <<  WTERMSIG   (ji.exit_code)       <<'-'<< ::strsignal(WTERMSIG(ji.exit_code)        ) ;
+				else if (!WIFEXITED  (ji.exit_code)     ) js.msg << "??"                                                                                            ;   // weird, could be a FAIL
+				else if ( WEXITSTATUS(ji.exit_code)>0x80) js.msg << "signal " << (WEXITSTATUS(ji.exit_code)-0x80) <<'-'<< ::strsignal(WEXITSTATUS(ji.exit_code)-0x80) ; // cf comment above
+				else if ( WEXITSTATUS(ji.exit_code)!=0  ) js.msg << "exit "   <<  WEXITSTATUS(ji.exit_code)                                                          ;
+				else                                     js.msg << "ok"                                                                                              ;
+				/**/                                     js.msg << ')'                                                                                               ;
+				js.ok = No ;
+			break ;
+		//	case JOB_END :                                                                          // not a real state, last entry in table
+			default      : FAIL_PROD("Slurm : wrong job state return for job (",ji.job_id,") : ") ; // NO_COV
+		}
+		js.done = true ;
+		if (ji.nodes) js.msg << (::strchr(ji.nodes,' ')==nullptr?" on node : ":" on nodes : ") << ji.nodes ;
+	}
 
-	static ::pair_s<Bool3/*job_ok*/> _job_state(SlurmId slurm_id) {                                                                                             // Maybe means job has not completed
+	// task_str is of the form 1,3-5,7-11:2%4 (with an optional throttle after %)
+	static bool _in_task_str( const char* task_str , uint32_t task ) {
+		if (!task_str) return true ;                                   // no info, assume task is in
+		::string_view ts = task_str ; ts = ts.substr(0,ts.find('%')) ;
+		try {
+			for( ::string const& item : split(ts,',') ) {
+				size_t   dash  = item.find('-')                                                                   ;
+				size_t   colon = item.find(':')                                                                   ;
+				uint32_t first = from_string<uint32_t>(item.substr(0,::min(dash,colon)))                          ;
+				uint32_t last  = dash ==Npos ? first : from_string<uint32_t>(item.substr(dash+1,colon-(dash+1))) ;
+				uint32_t step  = colon==Npos ? 1     : from_string<uint32_t>(item.substr(colon+1             )) ;
+				if ( task>=first && task<=last && (task-first)%step==0 ) return true ;
+			}
+		} catch (::string const&) { return true ; }                    // e.g. truncated list, assume task is in
+		return false ;
+	}
+
+	static ::pair_s<Bool3/*job_ok*/> _job_state(SpawnId id) {                                                                                                   // Maybe means job has not completed
 		static constexpr int NTrials = SockFd::NConnectTrials ;
-		Trace trace(BeChnl,"slurm_job_state",slurm_id) ;
+		SlurmId  slurm_id = spawn_job (id) ;
+		uint32_t task     = spawn_task(id) ;
+		Trace trace(BeChnl,"slurm_job_state",spawn_id_str(id)) ;
 		SWEAR(slurm_id) ;
 		job_info_msg_t* resp = nullptr/*garbage*/ ;
 		for( [[maybe_unused]] int i : iota(NTrials) ) {
@@ -199,58 +316,84 @@ namespace Backends::Slurm::SlurmApi {
 			default                                  : return { cat("cannot load job info (",errno," after ",NTrials,"trials) : ",_strerror(errno)) , Yes   } ; // ... eventually cancel
 		}
 	Report :
-		::string                msg ;
-		Bool3                   ok  = Yes     ;
-		slurm_job_info_t const* ji  = nullptr ;
-		for ( uint32_t i=0 ; i<resp->record_count ; i++ ) {
-			ji = &resp->job_array[i] ;
-			job_states js = job_states( ji->job_state & JOB_STATE_BASE ) ;
-			switch (js) {
-				// if slurm sees job failure, somthing weird occurred (if actual job fails, job_exec reports an error and completes successfully)
-				// possible job_states values (from slurm.h) :
-				case JOB_PENDING   :                             ok = Maybe ; continue  ; // queued waiting for initiation
-				case JOB_RUNNING   :                             ok = Maybe ; continue  ; // allocated resources and executing
-				case JOB_SUSPENDED :                             ok = Maybe ; continue  ; // allocated resources, execution suspended
-				case JOB_COMPLETE  :                                          continue  ; // completed execution successfully
-				case JOB_CANCELLED : msg = "cancelled by user" ; ok = Yes   ; goto Done ; // cancelled by user
-				case JOB_TIMEOUT   : msg = "timeout"           ; ok = No    ; goto Done ; // terminated on reaching time limit
-				case JOB_NODE_FAIL : msg = "node failure"      ; ok = Yes   ; goto Done ; // terminated on node failure
-				case JOB_PREEMPTED : msg = "preempted"         ; ok = Yes   ; goto Done ; // terminated due to preemption
-				case JOB_BOOT_FAIL : msg = "boot failure"      ; ok = Yes   ; goto Done ; // terminated due to node boot failure
-				case JOB_DEADLINE  : msg = "deadline reached"  ; ok = Yes   ; goto Done ; // terminated on deadline
-				case JOB_OOM       : msg = "out of memory"     ; ok = No    ; goto Done ; // experienced out of memory error
-				case JOB_FAILED :                                                         // completed execution unsuccessfully
-					// when job_exec receives a signal, the bash process which launches it (which the process seen by slurm) exits with an exit code > 128
-					// however, the user is interested in the received signal, not mapped bash exit code, so undo mapping
-					// signaled wstatus are barely the signal number
-					/**/                                       msg = "failed ("                                                                                           ;
-					if      ( WIFSIGNALED(ji->exit_code)     ) msg << "signal " <<  WTERMSIG   (ji->exit_code)       <<'-'<< ::strsignal(WTERMSIG(ji->exit_code)        ) ;
-					else if (!WIFEXITED  (ji->exit_code)     ) msg << "??"                                                                                                ; // weird, could be a FAIL
-					else if ( WEXITSTATUS(ji->exit_code)>0x80) msg << "signal " << (WEXITSTATUS(ji->exit_code)-0x80) <<'-'<< ::strsignal(WEXITSTATUS(ji->exit_code)-0x80) ; // cf comment above
-					else if ( WEXITSTATUS(ji->exit_code)!=0  ) msg << "exit "   <<  WEXITSTATUS(ji->exit_code)                                                            ;
-					else                                       msg << "ok"                                                                                                ;
-					/**/                                       msg << ')'                                                                                                 ;
-					ok = No ;
-					goto Done ;
-			//	case JOB_END :                                                                         // not a real state, last entry in table
-				default      : FAIL_PROD("Slurm : wrong job state return for job (",slurm_id,") : ") ; // NO_COV
+		_JobState js    ;
+		bool      found = false ; // for array tasks, task has its own record, else it is pending in the array record
+		if (task!=NoTask)
+			for( uint32_t i : iota(resp->record_count) ) found |= resp->job_array[i].array_task_id==task ;
+		for( uint32_t i : iota(resp->record_count) ) {
+			slurm_job_info_t const& ji = resp->job_array[i] ;
+			if (task!=NoTask) {
+				if      (found                                                            ) { if (ji.array_task_id!=task) continue ; }
+				else if ( ji.array_task_id!=NO_VAL || !_in_task_str(ji.array_task_str,task) )                               continue ;
+			}
+			_merge_job_state(js,ji) ;
+		}
+		_free_job_info_msg(resp) ;
+		return { js.msg , js.ok } ;
+	}
+
+	// job states are sampled with a single request for all our jobs, snapshot is flushed once every heartbeat round
+	struct _ArrayState {
+		::string  task_str ;                                                                                          // tasks still collapsed in array record
+		_JobState state    ;
+	} ;
+	// snapshot is protected by slurm_mutex
+	static bool                        _s_job_states_ok = false ;
+	static ::umap<SpawnId,_JobState  > _s_job_states    ;
+	static ::umap<SlurmId,_ArrayState> _s_array_states  ;                                                             // for array records with pending tasks
+	static void _refresh_job_states() {                                                                               // slurm_mutex must be locked
+		Trace trace(BeChnl,"slurm_refresh_job_states") ;
+		job_info_msg_t* resp = nullptr/*garbage*/ ;
+		if (_load_job_user(&resp,::getuid(),SHOW_LOCAL)!=SLURM_SUCCESS) { trace("cannot_load",errno) ; return ; }     // jobs will be queried individually
+		_s_job_states  .clear() ;
+		_s_array_states.clear() ;
+		for( uint32_t i : iota(resp->record_count) ) {
+			slurm_job_info_t const& ji = resp->job_array[i] ;
+			if ( ji.array_job_id && ji.array_task_id==NO_VAL ) {                                                      // record gathering pending tasks of an array
+				_ArrayState& as = _s_array_states[ji.array_job_id] ;
+				if (ji.array_task_str) as.task_str = ji.array_task_str ;
+				_merge_job_state(as.state,ji) ;
+				continue ;
 			}
+			SpawnId id ;
+			if      ( ji.het_job_id && ji.het_job_id!=NO_VAL ) id = mk_spawn_id(ji.het_job_id                     ) ; // all components are merged
+			else if ( ji.array_job_id                        ) id = mk_spawn_id(ji.array_job_id,ji.array_task_id) ;
+			else                                               id = mk_spawn_id(ji.job_id                         ) ;
+			_merge_job_state(_s_job_states[id],ji) ;
 		}
-	Done :
-		if ( +msg && ji->nodes ) msg << (::strchr(ji->nodes,' ')==nullptr?" on node : ":" on nodes : ") << ji->nodes ;
 		_free_job_info_msg(resp) ;
-		return { msg , ok } ;
+		_s_job_states_ok = true ;
+		trace("done",_s_job_states.size(),_s_array_states.size()) ;
+	}
+	static ::pair_s<Bool3/*job_ok*/> _bulk_job_state(SpawnId id) {                                                    // Maybe means job has not completed
+		{	Lock lock { slurm_mutex } ;
+			if (!_s_job_states_ok) _refresh_job_states() ;
+			if (_s_job_states_ok) {
+				if ( auto it=_s_job_states.find(id) ; it!=_s_job_states.end() ) return { it->second.msg , it->second.ok } ;
+				if ( uint32_t task=spawn_task(id) ; task!=NoTask )
+					if ( auto it=_s_array_states.find(spawn_job(id)) ; it!=_s_array_states.end() && _in_task_str(it->second.task_str.c_str(),task) )
+						return { it->second.state.msg , it->second.state.ok } ;
+			}
+		}
+		return _job_state(id) ;                                                                                       // not in snapshot (e.g. submitted after it was taken), ask slurm
+	}
+	static void _flush_job_states() {
+		Lock lock { slurm_mutex } ;
+		_s_job_states_ok = false ;
 	}
 
-	static void _cancel(SlurmId slurm_id) {
+	static void _cancel(SpawnId id) {
 		//This for loop with a retry comes from the scancel Slurm utility code
 		//Normally we kill mainly waiting jobs, but some "just started jobs" could be killed like that also
 		//Running jobs are killed by lmake/job_exec
-		Trace trace(BeChnl,"slurm_cancel",slurm_id) ;
+		::string id_str = spawn_id_str(id) ;
+		Trace trace(BeChnl,"slurm_cancel",id_str) ;
 		int  i    = 0/*garbage*/   ;
 		Lock lock { slurm_mutex } ;
 		for( i=0 ; i<SlurmCancelTrials ; i++ ) {
-			if (_kill_job(slurm_id,SIGKILL,KILL_FULL_JOB)==SLURM_SUCCESS) { trace("done") ; return ; }
+			int rc = spawn_task(id)==NoTask ? _kill_job (spawn_job(id)  ,SIGKILL,KILL_FULL_JOB                      ) // array tasks can only be designated by a string
+			/**/                            : _kill_job2(id_str.c_str(),SIGKILL,KILL_FULL_JOB,nullptr/*sibling*/) ;
+			if (rc==SLURM_SUCCESS) { trace("done") ; return ; }
 			switch (errno) {
 				case ESLURM_INVALID_JOB_ID             :
 				case ESLURM_ALREADY_DONE               : trace("already_dead",errno) ;                return ;
@@ -259,7 +402,7 @@ namespace Backends::Slurm::SlurmApi {
 			}
 		}
 	Bad :
-		FAIL_PROD("cannot cancel job ",slurm_id," after ",i," retries : ",_strerror(errno)) ; // NO_COV
+		FAIL_PROD("cannot cancel job ",id_str," after ",i," retries : ",_strerror(errno)) ;                           // NO_COV
 	}
 
 	template<class T> static void _load_func( T*& dst , const char* name ) {
@@ -279,17 +422,22 @@ namespace Backends::Slurm::SlurmApi {
 		_load_func( _free_submit_response_response_msg , "slurm_free_submit_response_response_msg" ) ;
 		_load_func( _init_job_desc_msg                 , "slurm_init_job_desc_msg"                 ) ;
 		_load_func( _kill_job                          , "slurm_kill_job"                          ) ;
+		_load_func( _kill_job2                         , "slurm_kill_job2"                         ) ;
 		_load_func( _list_append                       , "slurm_list_append"                       ) ;
 		_load_func( _list_create                       , "slurm_list_create"                       ) ;
 		_load_func( _list_destroy                      , "slurm_list_destroy"                      ) ;
 		_load_func( _load_job                          , "slurm_load_job"                          ) ;
+		_load_func( _load_job_user                     , "slurm_load_job_user"                     ) ;
 		_load_func( _strerror                          , "slurm_strerror"                          ) ;
 		_load_func( _submit_batch_het_job              , "slurm_submit_batch_het_job"              ) ;
 		_load_func( _submit_batch_job                  , "slurm_submit_batch_job"                  ) ;
 		//
-		spawn_job_func = _spawn_job ;
-		job_state_func = _job_state ;
-		cancel_func    = _cancel    ;
+		spawn_job_func        = _spawn_job        ;
+		spawn_array_func      = _spawn_array      ;
+		job_state_func        = _job_state        ;
+		bulk_job_state_func   = _bulk_job_state   ;
+		flush_job_states_func = _flush_job_states ;
+		cancel_func           = _cancel           ;
 		//
 		Daemon res ;
 		#if SLURM_VERSION_NUMBER>=SLURM_VERSION_NUM(25,11,0)
@@ -1008,8 +1008,9 @@ namespace Engine {
 								start.mk_lmake_version() ;
 								start.update_env( /*out*/::ref(::vmap_ss())/*dyn_env*/ , start.autodep_env.repo_root_s , start.autodep_env.tmp_dir_s ) ;
 								//
-								if (+si.reason            ) push_entry( "reason" , localize(reason_str(si.reason),su)     ) ;
-								if (pre_start.service.addr) push_entry( "host"   , SockFd::s_host(pre_start.service.addr) ) ;
+								if (+si.reason            ) push_entry( "reason"    , localize(reason_str(si.reason),su)     ) ;
+								if (pre_start.service.addr) push_entry( "host"      , SockFd::s_host(pre_start.service.addr) ) ;
+								if (+rs.placement         ) push_entry( "placement" , rs.placement                           ) ;
 								//
 								if (+rs.eta) {
 									if (porcelaine) push_entry( "scheduling" , "( "+mk_py_str(rs.eta.str())+" , "+::to_string(double(si.pressure))+" )"      , Color::None,false/*protect*/ ) ;
@@ -1065,6 +1066,7 @@ namespace Engine {
 							if ( +end && digest.status>Status::Early ) {
 								bool lost     = is_lost(digest.status)                         ;
 								bool has_z_sz = end.total_z_sz && end.total_z_sz!=end.total_sz ;
+								bool has_io   = end.stats.io_read || end.stats.io_write        ;
 								// no need to localize phy_tmp_dir as this is an absolute dir
 								if (!lost) {
 									if (+start.job_space.tmp_view_s) push_entry( "physical tmp dir" , no_slash(end.phy_tmp_dir_s) ) ;
@@ -1077,6 +1079,9 @@ namespace Engine {
 									if ( !lost                       ) push_entry( "elapsed_in_job"        , ::to_string(double(end.stats.job  )) , {} , false ) ;
 									/**/                               push_entry( "elapsed_total"         , ::to_string(double(digest.exe_time)) , {} , false ) ;
 									if ( !lost                       ) push_entry( "used_mem"              , cat        (end.stats.mem          ) , {} , false ) ;
+									if ( !lost                       ) push_entry( "io_read"               , cat        (end.stats.io_read      ) , {} , false ) ;
+									if ( !lost                       ) push_entry( "io_write"              , cat        (end.stats.io_write     ) , {} , false ) ;
+									if ( !lost                       ) push_entry( "used_tmp"              , cat        (end.stats.tmp          ) , {} , false ) ;
 									/**/                               push_entry( "cost"                  , ::to_string(double(job->cost()    )) , {} , false ) ;
 									if ( !lost                       ) push_entry( "total_size"            , cat        (end.total_sz           ) , {} , false ) ;
 									if ( !lost && has_z_sz           ) push_entry( "total_compressed_size" , cat        (end.total_z_sz         ) , {} , false ) ;
@@ -1096,6 +1101,9 @@ namespace Engine {
 									if ( !lost                       ) push_entry( "elapsed in job"        , end.stats.job  .short_str()                                                         ) ;
 									/**/                               push_entry( "elapsed total"         , digest.exe_time.short_str()                                                         ) ;
 									if ( !lost                       ) push_entry( "used mem"              , mem_str                                       , overflow?Color::Warning:Color::None ) ;
+									if ( !lost && has_io             ) push_entry( "io read"               , to_short_string_with_unit(end.stats.io_read )+'B'                                   ) ;
+									if ( !lost && has_io             ) push_entry( "io written"            , to_short_string_with_unit(end.stats.io_write)+'B'                                   ) ;
+									if ( !lost && end.stats.tmp      ) push_entry( "used tmp"              , to_short_string_with_unit(end.stats.tmp     )+'B'                                   ) ;
 									/**/                               push_entry( "cost"                  , job->cost()     .short_str()                                                        ) ;
 									if ( !lost                       ) push_entry( "total targets size"    , to_short_string_with_unit(end.total_sz  )+'B'                                       ) ;
 									if ( !lost && has_z_sz           ) push_entry( "total compressed size" , to_short_string_with_unit(end.total_z_sz)+'B' , z_sz_color                          ) ;
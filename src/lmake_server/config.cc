@@ -115,19 +115,24 @@ namespace Engine {
 			//
 			{	::string& f0 = fields[0] ;                                                                     // has long as fields in not pushed/popped, we can store a ref into it
 				//
+				f0 = "cgroup"              ; if (py_map.contains(f0))   cgroup_s               = with_slash(py_map[f0].as_a<Str  >()) ;
 				f0 = "disk_date_precision" ; if (py_map.contains(f0)) { ddate_prec             = Delay     (py_map[f0].as_a<Float>()) ; throw_unless( ddate_prec    >Delay() , "must be positive" ) ; }
 				f0 = "heartbeat"           ; if (py_map.contains(f0)) { heartbeat              = Delay     (py_map[f0].as_a<Float>()) ; throw_unless( heartbeat     >Delay() , "must be positive" ) ; }
 				f0 = "heartbeat_tick"      ; if (py_map.contains(f0)) { heartbeat_tick         = Delay     (py_map[f0].as_a<Float>()) ; throw_unless( heartbeat_tick>Delay() , "must be positive" ) ; }
+				f0 = "job_relay"           ; if (py_map.contains(f0))   job_relay              = +         py_map[f0]                 ;
 				f0 = "local_admin_dir"     ; if (py_map.contains(f0))   user_local_admin_dir_s = with_slash(py_map[f0].as_a<Str  >()) ;
 				f0 = "max_dep_depth"       ; if (py_map.contains(f0))   max_dep_depth          = size_t    (py_map[f0].as_a<Int  >()) ;
 				f0 = "max_error_lines"     ; if (py_map.contains(f0))   max_err_lines          = size_t    (py_map[f0].as_a<Int  >()) ;
 				f0 = "network_delay"       ; if (py_map.contains(f0)) { network_delay          = Delay     (py_map[f0].as_a<Float>()) ; throw_unless( network_delay >Delay() , "must be positive" ) ; }
 				f0 = "nice"                ; if (py_map.contains(f0))   nice                   = uint8_t   (py_map[f0].as_a<Int  >()) ;
+				f0 = "predict_resources"   ; if (py_map.contains(f0))   predict_rsrcs          = +         py_map[f0]                 ;
 				f0 = "req_start_proc"      ; if (py_map.contains(f0))   req_start_proc         = with_nl   (py_map[f0].as_a<Str  >()) ;
 				f0 = "req_end_proc"        ; if (py_map.contains(f0))   req_end_proc           = with_nl   (py_map[f0].as_a<Str  >()) ;
 				f0 = "server_start_proc"   ; if (py_map.contains(f0))   server_start_proc      = with_nl   (py_map[f0].as_a<Str  >()) ;
 				f0 = "server_end_proc"     ; if (py_map.contains(f0))   server_end_proc        = with_nl   (py_map[f0].as_a<Str  >()) ;
 				f0 = "system_tag_proc"     ; if (py_map.contains(f0))   system_tag_proc        = with_nl   (py_map[f0].as_a<Str  >()) ;
+				f0 = "tmp_fs"              ; if (py_map.contains(f0))   tmp_fs                 = +         py_map[f0]                 ;
+				f0 = "watch_deps"          ; if (py_map.contains(f0))   watch_deps             = +         py_map[f0]                 ;
 				//
 				f0 = "extra_manifest" ;
 				if (py_map.contains(f0)) {
@@ -400,10 +405,15 @@ namespace Engine {
 		//
 		// dynamic
 		//
-		/**/               res << "dynamic :\n"                                  ;
-		/**/               res << "\tfile_sync       : " << file_sync     <<'\n' ;
-		if (max_err_lines) res << "\tmax_error_lines : " << max_err_lines <<'\n' ;
-		if (nice         ) res << "\tnice            : " << size_t(nice)  <<'\n' ;
+		/**/               res << "dynamic :\n"                                    ;
+		if (+cgroup_s    ) res << "\tcgroup            : " << no_slash(cgroup_s)<<'\n' ;
+		/**/               res << "\tfile_sync         : " << file_sync     <<'\n' ;
+		if (job_relay    ) res << "\tjob_relay         : " << job_relay     <<'\n' ;
+		if (max_err_lines) res << "\tmax_error_lines   : " << max_err_lines <<'\n' ;
+		if (nice         ) res << "\tnice              : " << size_t(nice)  <<'\n' ;
+		if (predict_rsrcs) res << "\tpredict_resources : " << predict_rsrcs <<'\n' ;
+		if (tmp_fs       ) res << "\ttmp_fs            : " << tmp_fs        <<'\n' ;
+		if (watch_deps   ) res << "\twatch_deps        : " << watch_deps    <<'\n' ;
 		//
 		res << "\tbackends :\n" ;
 		for( BackendTag t : iota(1,All<BackendTag>) ) {      // local backend is always present
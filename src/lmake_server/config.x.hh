@@ -188,10 +188,15 @@ namespace Engine {
 		size_t n_errs       (size_t n) const { if (errs_overflow(n)) return max_err_lines-1 ; else return n ; }
 		// data
 		// START_OF_VERSIONING REPO
+		::string                                                                cgroup_s            ;         // if non-empty, cgroup v2 dir under which jobs are run, each in its own sub-cgroup
 		FileSync                                                                file_sync           = {}    ; // method to ensure file sync when over an unreliable filesystem such as NFS
+		bool                                                                    job_relay           = false ; // if true, remote jobs report to server through a per-host relay
 		size_t                                                                  max_err_lines       = 0     ; // unlimited
 		uint8_t                                                                 nice                = 0     ; // nice value applied to jobs
+		bool                                                                    predict_rsrcs       = false ; // if true, jobs are submitted with cpu & mem predicted from history
 		FileSync                                                                server_file_sync    = {}    ; // method to use on server side
+		bool                                                                    tmp_fs              = false ; // if true, tmp dir of jobs declaring a tmp resource is a tmpfs of that size
+		bool                                                                    watch_deps          = false ; // if true, jobs are killed and rerun as soon as a dep they have read is modified
 		Collect                                                                 collect             ;
 		Console                                                                 console             ;
 		bool                                                                    has_remote_backends = false ;
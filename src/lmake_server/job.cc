@@ -77,6 +77,7 @@ namespace Engine {
 
 	QueueThread<::pair<Job,JobInfo1>,true/*Flush*/,true/*QueueAccess*/> Job::s_record_thread ;
 	StaticUniqPtr<RealPath>                                             Job::s_real_path     ;
+	::umap<Job,Job::RsrcsHistory>                                       Job::s_rsrcs_history ;
 	//
 	StaticUniqPtr<RealPathEnv> Job::_s_rpe ;
 
@@ -645,6 +646,26 @@ namespace Engine {
 			//^^^^^^^^^^^^^^^^^^
 		}
 		//
+		// handle resources history
+		//
+		if ( ok==Yes && +stats.job ) {
+			double   n_cpus = ::ceil( double(Delay(stats.cpu)) / double(Delay(stats.job)) ) ;
+			uint16_t cpu    = ::min( ::max( n_cpus , 1. ) , double(uint16_t(-1)) )          ;
+			rule->new_rsrcs_report( stats.mem , cpu ) ;
+			if (g_config->predict_rsrcs) { RsrcsHistory& h = s_rsrcs_history[self] ; h.mem = stats.mem ; h.cpu = cpu ; }
+		}
+		if (g_config->predict_rsrcs) {
+			auto it = s_rsrcs_history.find(self) ;
+			if ( it!=s_rsrcs_history.end() && it->second.predicted ) {
+				it->second.predicted = false ;
+				if ( ok==No && !lost ) {                                                                        // lacking resources is a probable cause, retry with declared ones
+					trace("predicted_rsrcs_err") ;
+					it->second.declared  = true                ;
+					res.target_reason   |= JobReasonTag::Rsrcs ;
+				}
+			}
+		}
+		//
 		// wrap up
 		//
 		jd.set_exec_ok() ;                                                                                       // effect of old cmd has gone away with job execution
@@ -743,6 +764,7 @@ namespace Engine {
 		if (+digest.upload_key) {
 			/**/                                                                          SWEAR( cache_idx1 , cache_idx1 ) ;                  // cannot commit/dismiss without cache
 			Cache::CacheServerSide& cache = Cache::CacheServerSide::s_tab[cache_idx1-1] ; SWEAR( +cache     , cache_idx1 ) ;                  // .
+			Pdate                   start = New                                           ;
 			end_digest.can_upload &= !( jd.missing() || jd.err() ) ;                                                                          // only cache execution without errors
 			try {
 				if (end_digest.can_upload) cache.commit ( self , digest.upload_key , was_missing_audit , cache_force , digest.targets_crc ) ;
@@ -755,6 +777,8 @@ namespace Engine {
 					req->audit_stderr(                                            self , {.msg=e}       ) ;
 				}
 			}
+			Delay cache_time = Pdate(New)-start ;
+			for( Req req : end_digest.running_reqs ) req->stats.cache_time += cache_time ;
 		}
 		for( ReqIdx i : iota(end_digest.running_reqs.size()) ) {
 			Req      req = end_digest.running_reqs[i] ;
@@ -854,21 +878,25 @@ namespace Engine {
 	}
 
 	void JobInfoStart::operator>>(::string& os) const {                                    // START_OF_NO_COV
-		os << "JobInfoStart("<<submit_info<<','<<rsrcs<<','<<pre_start<<','<<start <<')' ;
+		/**/            os << "JobInfoStart("<<submit_info<<','<<rsrcs<<','<<pre_start<<','<<start ;
+		if (+placement) os << ','<<placement                                                  ;
+		/**/            os << ')'                                                             ;
 	}                                                                                      // END_OF_NO_COV
 
 	void JobInfoStart::cache_cleanup() {
 		submit_info.cache_cleanup() ;
 		pre_start  .cache_cleanup() ;
 		start      .cache_cleanup() ;
-		eta = {} ;                    // execution dependent
+		eta       = {} ;              // execution dependent
+		placement = {} ;              // .
 	}
 
 	void JobInfoStart::chk(bool for_cache) const {
 		submit_info.chk(for_cache) ;
 		pre_start  .chk(for_cache) ;
 		start      .chk(for_cache) ;
-		if (for_cache) throw_unless( !eta , "bad eta" ) ;
+		if (for_cache) throw_unless( !eta       , "bad eta"       ) ;
+		if (for_cache) throw_unless( !placement , "bad placement" ) ;
 	}
 
 	void JobInfo::fill_from(::string const& filename , JobInfoKinds need ) {
@@ -91,11 +91,19 @@ namespace Engine {
 		using ReqInfo    = JobReqInfo    ;
 		using MakeAction = JobMakeAction ;
 		using Step       = JobStep       ;
+		//
+		struct RsrcsHistory {
+			size_t   mem       = 0     ; // peak memory (in bytes) used by last ok run, 0 means unknown
+			uint16_t cpu       = 0     ; // average number of cpus used by last ok run, rounded up, 0 means unknown
+			bool     predicted = false ; // if true <=> job was last submitted with predicted resources
+			bool     declared  = false ; // if true <=> job failed with predicted resources, use declared ones from now on
+		} ;
 		// statics
 		static void s_init() ;
 		// static data
 		static QueueThread<::pair<Job,JobInfo1>,true/*Flush*/,true/*QueueAccess*/> s_record_thread ;
 		static StaticUniqPtr<RealPath>                                             s_real_path     ;
+		static ::umap<Job,RsrcsHistory>                                            s_rsrcs_history ; // only used if config.predict_rsrcs, not stored on disk
 	private :
 		static StaticUniqPtr<RealPathEnv> _s_rpe ;
 
@@ -210,6 +218,7 @@ namespace Engine {
 		uint16_t    max_stderr_len = 0 ;
 		in_addr_t   host           = 0 ;
 		CoarseDelay cost           ;                                       // exec time / average number of running job during execution
+		JobStats    stats          ;                                       // resources actually used by job
 		Pdate       start_date     ;
 		Pdate       end_date       ;                                       // if no end_date, job is stil on going
 	} ;
@@ -360,6 +369,7 @@ namespace Engine {
 		::vmap_ss        rsrcs        = {} ;
 		JobStartRpcReq   pre_start    = {} ;
 		JobStartRpcReply start        = {} ;
+		::string         placement    = {} ; // cpus and memory nodes job was bound to by backend, if any
 		// END_OF_VERSIONING
 	} ;
 
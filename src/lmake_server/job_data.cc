@@ -758,7 +758,8 @@ namespace Engine {
 		report_reason = reason(ri.state) ;
 		goto Return ;
 	Wait :
-		if (+missing_rerun_report) req->audit_job( Color::Note , cat(missing_rerun_report,"_rerun") , job ) ;
+		if (+missing_rerun_report  ) req->audit_job( Color::Note , cat(missing_rerun_report,"_rerun") , job ) ;
+		if (special_==Special::Dep ) Backend::s_suspend(asking_job()) ;                                        // asking job must wait for deps, dont hold its resources meanwhile
 		trace("wait",ri) ;
 	Return :
 		return {report_reason,triggered} ;
@@ -1084,6 +1085,29 @@ namespace Engine {
 		return {maybe_new_deps,true/*triggered*/} ;
 	}
 
+	// lower declared cpu & mem to what job (or its rule if job has not run yet) actually used, with some margin for memory
+	static void _predict_rsrcs( Job job , ::vmap_ss&/*inout*/ rsrcs ) {
+		static constexpr size_t MemMargin = 4 ;                                                                        // add 1/MemMargin to observed memory
+		Trace trace("_predict_rsrcs",job) ;
+		Job::RsrcsHistory& h   = Job::s_rsrcs_history[job]             ; if (h.declared) return ;
+		size_t             mem = h.mem ? h.mem : job->rule()->peak_mem ;
+		uint16_t           cpu = h.cpu ? h.cpu : job->rule()->peak_cpu ;
+		bool               res = false                                 ;
+		for( auto& [k,v] : rsrcs ) {
+			try {
+				if ( k=="mem" && mem ) {
+					size_t mem_mb = ((mem+mem/MemMargin)>>20)+1 ;
+					if (mem_mb<from_string_with_unit<'M',size_t,true/*RndUp*/>(v)) { v = to_string_with_unit<'M'>(mem_mb) ; res = true ; }
+				}
+				if ( k=="cpu" && cpu ) {
+					if (cpu<from_string_with_unit<size_t,true/*RndUp*/>(v)) { v = ::to_string(cpu) ; res = true ; }
+				}
+			} catch (::string const&) {}                                                                               // resource cannot be interpreted, leave it to the backend
+		}
+		h.predicted = res ;
+		trace(STR(res),rsrcs) ;
+	}
+
 	::pair<bool/*maybe_new_deps*/,bool/*triggered*/> JobData::_submit_plain( ReqInfo& ri , CoarseDelay pressure ) {
 		using Step = JobStep ;
 		Rule            r     = rule() ;
@@ -1135,10 +1159,13 @@ namespace Engine {
 			/**/                            cache_idx1   = it->second+1                       ; if (!has_download(req->cache_method)) { cache_hit_info = CacheHitInfo::NoDownload ; goto CacheDone ; }
 			CacheServerSide::DownloadDigest cache_digest ;
 			JobInfo&                        job_info     = cache_digest.job_info              ;
+			Pdate                           cache_start  { New }                              ;
 			try { //!          vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 				cache_digest = cache.download( job , match , !req->options.flags[ReqFlag::NoIncremental] ) ;
 				//             ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+				req->stats.add_cache_download(Pdate(New)-cache_start) ;
 			} catch (::string const& e) {
+				req->stats.add_cache_download(Pdate(New)-cache_start) ;
 				trace("cache_download_throw",e) ;
 				req->audit_job ( Color::Warning , "bad_cache_download" , job ) ;
 				req->audit_info( Color::Note    , e , 1/*lvl*/               ) ;
@@ -1252,6 +1279,7 @@ namespace Engine {
 			,	.tokens1    =        tokens1_
 			} ;
 			estimate_stats(tokens1_) ;                       // refine estimate with best available info just before submitting
+			if (g_config->predict_rsrcs) _predict_rsrcs( job , submit_rsrcs_attrs.rsrcs ) ;
 			rsrcs_done = true ;                              // for trace only
 			//       vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 			Backend::s_submit( backend , +job , +req , ::move(si) , ::move(submit_rsrcs_attrs.rsrcs) ) ;
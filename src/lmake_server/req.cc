@@ -465,7 +465,8 @@ namespace Engine {
 			::string t = +stats.jobs_time[+jr] ? stats.jobs_time[+jr].short_str() : ::string(Delay::ShortStrSz,' ') ;
 			audit_info( c , widen(snake_str(jr),wk)+" time : "+t+" ("+widen(cat(stats.ended[+jr]),wn,true/*right*/)+" jobs)" ) ;
 		}
-		/**/                                   audit_info( Color::Note , cat(widen("elapsed",wk)," time : ",(Pdate(New)-start_pdate).short_str()) ) ;
+		if (+stats.cache_time                ) audit_info( Color::Note , cat(widen("cache"  ,wk)," time : ",stats.cache_time.short_str()," (",stats.cache_downloads," downloads)") ) ;
+		/**/                                   audit_info( Color::Note , cat(widen("elapsed",wk)," time : ",(Pdate(New)-start_pdate).short_str()                                  ) ) ;
 		if (+options.startup_dir_s           ) audit_info( Color::Note , cat(widen("startup",wk)," dir  : ",options.startup_dir_s,rm_slash      ) ) ;
 		//
 		if (job_up_to_date) {
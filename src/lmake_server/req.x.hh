@@ -126,10 +126,13 @@ namespace Engine {
 			sub(from,exec_time) ;
 			add(to  ,exec_time) ;
 		}
+		void add_cache_download(Delay d) { cache_time += d ; cache_downloads++ ; }
 		// data
 		Delay  jobs_time[N<JobReport>] ;
 		JobIdx ended    [N<JobReport>] = {} ;
 		Delay  waiting_cost            ;      // cost of all waiting jobs
+		Delay  cache_time              ;      // time spent accessing caches (download, commit and dismiss)
+		JobIdx cache_downloads         = 0  ;
 	private :
 		JobIdx _cur[+JobStep::MaxCurStats1-+JobStep::MinCurStats] = {} ;
 	} ;
@@ -558,8 +558,9 @@ namespace Engine {
 		::string gen_py_line(       Rule::RuleMatch const& m       , VarCmd vc , VarIdx i , ::string const& key , ::string const& val ) const { // cannot lazy evaluate w/o a job
 			return gen_py_line( {} , const_cast<Rule::RuleMatch&>(m) , vc , i , key , val ) ;
 		}
-		void        new_job_report( Delay exe_time , CoarseDelay cost , Tokens1 ) const ;
-		CoarseDelay cost          (                                             ) const ;
+		void        new_job_report  ( Delay exe_time , CoarseDelay cost , Tokens1 ) const ;
+		void        new_rsrcs_report( size_t mem     , uint16_t cpu               ) const ;
+		CoarseDelay cost            (                                             ) const ;
 	private :
 		::vector_s    _list_ctx  ( ::vector<CmdIdx> const& ctx       ) const ;
 		void          _set_crcs  ( RulesBase        const&           ) ;
@@ -611,6 +612,8 @@ namespace Engine {
 		mutable Delay    exe_time       = {} ;                                     // average exe_time
 		mutable uint64_t tokens1_32     = 0  ; static_assert(sizeof(Tokens1)<=4) ; // average number of tokens1 <<32
 		mutable JobIdx   stats_weight   = 0  ;                                     // number of jobs used to compute average cost_per_token and exe_time
+		mutable size_t   peak_mem       = 0  ;                                     // max peak memory (in bytes) used by ok jobs
+		mutable uint16_t peak_cpu       = 0  ;                                     // max average number of cpus used by ok jobs
 		// END_OF_VERSIONING
 		//
 		// not stored on disk
@@ -975,6 +978,8 @@ namespace Engine {
 			::serdes(s,cost_per_token        ) ;
 			::serdes(s,exe_time              ) ;
 			::serdes(s,stats_weight          ) ;
+			::serdes(s,peak_mem              ) ;
+			::serdes(s,peak_cpu              ) ;
 		}
 		// derived
 		::serdes(s,stem_n_marks  ) ;
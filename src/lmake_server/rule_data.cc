@@ -472,6 +472,11 @@ namespace Engine {
 		tokens1_32     +=           tokens1_32_delta    /stats_weight  ;
 	}
 
+	void RuleData::new_rsrcs_report( size_t mem , uint16_t cpu ) const {
+		peak_mem = ::max(peak_mem,mem) ;
+		peak_cpu = ::max(peak_cpu,cpu) ;
+	}
+
 	CoarseDelay RuleData::cost() const {                          // compute cost_per_tokens * tokens, but takes care of the details
 		uint64_t    t_16   = (tokens1_32>>16)+(uint64_t(1)<<16) ;
 		Delay::Tick cpt_16 = cost_per_token.val()>>16           ;
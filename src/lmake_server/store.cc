@@ -506,6 +506,8 @@ namespace Engine::Persistent {
 				new_rd->cost_per_token = old_rd.cost_per_token ;
 				new_rd->exe_time       = old_rd.exe_time       ;
 				new_rd->stats_weight   = old_rd.stats_weight   ;
+				new_rd->peak_mem       = old_rd.peak_mem       ;
+				new_rd->peak_cpu       = old_rd.peak_cpu       ;
 			}
 		}
 		bool invalidate = n_new_rules || n_old_rules || modified_rule_order ;
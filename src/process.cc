@@ -110,6 +110,7 @@ void Child::spawn() {
 	if (pid_==0) {                                             // in child
 		// /!\ this section must be malloc free as malloc takes a lock that may be held by another thread at the time process is cloned
 		if (as_session) ::setsid() ;                           // if we are here, we are the init process and we must be in the new session to receive the kill signal
+		if (+cgroup_procs) { [[maybe_unused]] ssize_t rc = ::write( cgroup_procs , "0"/*self*/ , 1 ) ; }  // ignore error if any, job then runs in our cgroup and only accounting is degraded
 		if (nice) {
 			/**/             int fd  = ::open ( "/proc/self/autogroup" , O_WRONLY|O_TRUNC ) ;           // ignore error if any, as we cant do much about it
 			[[maybe_unused]] int rc1 = ::write( fd , nice_c_str , nice_str.size()         ) ;           // .
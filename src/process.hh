@@ -81,6 +81,7 @@ public :
 	// spawn parameters
 	::map_ss const* add_env            = nullptr    ;
 	bool            as_session         = false      ;
+	Fd              cgroup_procs       = {}         ; // if provided, cgroup.procs file of the cgroup child moves itself into before exec
 	::vector_s      cmd_line           = {}         ;
 	::string        cwd_s              = {}         ;
 	::map_ss const* env                = nullptr    ;
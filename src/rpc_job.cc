@@ -4,7 +4,8 @@
 // This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
 
 #include <linux/capability.h>
-#include <sched.h>            // unshare
+#include <sched.h>            // unshare, setns
+#include <sys/file.h>         // flock
 #include <sys/syscall.h>
 #include <sys/utsname.h>
 
@@ -12,6 +13,7 @@
 #include "hash.hh"
 #include "msg.hh"
 #include "process.hh"
+#include "thread.hh"
 #include "time.hh"
 #include "trace.hh"
 #include "version.hh"
@@ -253,13 +255,39 @@ void FileAction::operator>>(::string& os) const {               // START_OF_NO_C
 	/**/                             os << ')'                ;
 }                                                               // END_OF_NO_COV
 
+// washing files is mostly made of independent syscalls, which are slow on network filesystems
+// so when there are numerous files, it is done in parallel, files being grouped by dir to preserve locality
+// quarantine and dir removal are rare and need sync_guard, which is not thread-safe, so they are done afterwards, in order, as well as reporting
+static constexpr size_t WashParallelMin = 64 ; // min number of files to wash in parallel, below this, creating threads is not worth it
+
+struct WashEntry {
+	FileStat fs         = {}    ;
+	bool     exists     = false ;
+	bool     quarantine = false ;
+	bool     unlnked    = false ;
+	::string err        = {}    ;
+} ;
+
+static void _wash_file( ::string const& f , FileAction const& a , WashEntry&/*out*/ we ) {                                                             // /!\ may be called concurrently
+	if (::lstat(f.c_str(),&we.fs)!=0) return ;                                                                                                     // file does not exist, nothing to do
+	we.exists = true ;
+	if (a.tag==FileActionTag::Uniquify) return ;                                                                                                   // uniquification needs all links of a file
+	FileSig sig   { we.fs }                     ;
+	bool    empty = sig.tag()==FileTag::Empty ;
+	we.quarantine = sig.exists() && ( sig!=a.sig && !empty && ( a.crc==Crc::None || !a.crc.valid() || !a.crc.match(Crc(f)) ) ) ;                   // only compute crc if file has been modified
+	if ( we.quarantine || sig.tag()==FileTag::Dir ) return ;
+	try                       { unlnk(f) ; we.unlnked = true ; }
+	catch (::string const& e) { we.err = e ;                   }
+}
+
 ::string do_file_actions( ::vector_s&/*out*/ unlnks , bool&/*out*/ incremental , ::vmap_s<FileAction>&& pre_actions , SyncGuard* sync_guard ) {
 	::uset_s                  keep_dirs       ;
 	::string                  msg             ;
 	::string                  trash           ;
 	::uset_s                  existing_dirs_s ;
 	::umap<UniqKey,UniqEntry> uniq_tab        ;
-	FileStat                  fs              ;
+	::vector<size_t>          wash_idxs       ;                                                                                                      // indexes in pre_actions of files to wash
+	::vector<size_t>          wash_grps       ;                                                                                                      // indexes in wash_idxs where a new dir starts
 	//
 	auto dir_exists = [&](::string const& f) {
 		for( ::string d_s=dir_name_s(f) ; +d_s ; d_s = dir_name_s(d_s) )
@@ -268,27 +296,56 @@ void FileAction::operator>>(::string& os) const {               // START_OF_NO_C
 	//
 	Trace trace("do_file_actions") ;
 	unlnks.reserve(unlnks.size()+pre_actions.size()) ;                                                                                                 // most actions are unlinks
-	for( auto const& [f,a] : pre_actions ) {                                                                                                           // pre_actions are adequately sorted
+	for( size_t i : iota(pre_actions.size()) ) {
+		auto const& [f,a] = pre_actions[i] ;
 		SWEAR(+f) ;                                                                                                                                    // acting on root dir is non-sense
+		if ( a.tag<FileActionTag::None || a.tag>FileActionTag::HasFile ) continue ;
+		if (sync_guard) sync_guard->access(f) ;
+		if ( !wash_idxs || dir_name_s(f)!=dir_name_s(pre_actions[wash_idxs.back()].first) ) wash_grps.push_back(wash_idxs.size()) ;
+		wash_idxs.push_back(i) ;
+	}
+	/**/                    wash_grps.push_back(wash_idxs.size()) ;
+	::vector<WashEntry> wash_entries ( pre_actions.size() ) ;
+	size_t              nws          = wash_idxs.size()<WashParallelMin ? 1 : n_workers(wash_grps.size()-1) ;
+	Atomic<size_t>      grp_idx      = 0                                                                     ;
+	auto wash_func = [&](size_t id) {
+		if (id) t_thread_key = '0'+id ;
+		Trace trace("wash_func",id) ;
+		for( size_t g ; (g=grp_idx++)<wash_grps.size()-1 ;)
+			for( size_t wi : iota(wash_grps[g],wash_grps[g+1]) ) {
+				size_t i = wash_idxs[wi] ;
+				_wash_file( pre_actions[i].first , pre_actions[i].second , /*out*/wash_entries[i] ) ;
+			}
+	} ;
+	trace("wash",wash_idxs.size(),wash_grps.size()-1,nws) ;
+	if (nws==1) {                                                                                                                                      // fast path : avoid creating a single thread
+		wash_func(0) ;
+	} else {
+		::vector<::jthread> workers ; workers.reserve(nws) ;
+		for( size_t id : iota(nws) ) workers.emplace_back( wash_func , 1+id ) ;
+	}
+	for( size_t i : iota(pre_actions.size()) ) {                                                                                                       // pre_actions are adequately sorted
+		auto const& [f,a] = pre_actions[i] ;
 		switch (a.tag) {
 			case FileActionTag::None           :
 			case FileActionTag::Unlink         :
 			case FileActionTag::UnlinkWarning  :
 			case FileActionTag::UnlinkPolluted :
-			case FileActionTag::Uniquify       :
-				if (sync_guard               )   sync_guard->access(f) ;
-				if (::lstat(f.c_str(),&fs)!=0) { trace(a.tag,"no_file",f) ; continue ; }                                                               // file does not exist, nothing to do
+			case FileActionTag::Uniquify       : {
+				WashEntry const& we = wash_entries[i] ;
+				FileStat  const& fs = we.fs           ;
+				if (!we.exists) { trace(a.tag,"no_file",f) ; continue ; }                                                                              // file does not exist, nothing to do
 				dir_exists(f) ;                                                                                                                        // if a file exists, its dir necessarily exists
 				if (a.tag!=FileActionTag::Uniquify) {
-					FileSig sig         { fs }                                                                                                       ;
-					bool    empty       = sig.tag()==FileTag::Empty                                                                                  ;
-					bool    quarantine_ = sig.exists() && ( sig!=a.sig && !empty && ( a.crc==Crc::None || !a.crc.valid() || !a.crc.match(Crc(f)) ) ) ; // only compute crc if file has been modified
+					FileSig sig   { fs }                     ;
+					bool    empty = sig.tag()==FileTag::Empty ;
+					if (+we.err      ) throw we.err ;
 					if (!sig.exists()) trace(a.tag,"awkward",f,sig.tag()) ;
-					if (quarantine_) {
+					if (we.quarantine) {
 						quarantine( f , sync_guard ) ;
 						msg << "quarantined "<<mk_file(f)<<'\n' ;
 					} else {
-						unlnk(f,{.dir_ok=true,.sync_guard=sync_guard}) ;
+						if (!we.unlnked) unlnk(f,{.dir_ok=true,.sync_guard=sync_guard}) ;                                                              // dirs are not unlinked in parallel
 						if ( a.tag==FileActionTag::None && !a.tflags[Tflag::NoWarning] ) {                                   // if a file has been unlinked, its dir necessarily exists
 							/**/                              msg << "unlinked "      ;
 							if      (empty                  ) msg << "(empty) "       ;
@@ -297,7 +354,7 @@ void FileAction::operator>>(::string& os) const {               // START_OF_NO_C
 							/**/                              msg << mk_file(f)<<'\n' ;
 						}
 					}
-					trace(a.tag,STR(quarantine_),f) ;
+					trace(a.tag,STR(we.quarantine),f) ;
 					if (sig.exists()) unlnks.push_back(f) ;
 				} else {
 					if (a.tflags[Tflag::Target]                    ) { trace(a.tag,"incremental",f) ; incremental = true ; }
@@ -310,7 +367,7 @@ void FileAction::operator>>(::string& os) const {               // START_OF_NO_C
 					e.files.push_back(f) ;
 					e.no_warning &= a.tflags[Tflag::NoWarning] ;
 				}
-			break ;
+			} break ;
 			case FileActionTag::Mkdir : {
 				::string f_s = with_slash(f) ;
 				if (!existing_dirs_s.contains(f_s)) mk_dir_s(f_s,{.sync_guard=sync_guard}) ;
@@ -448,15 +505,14 @@ void JobSpace::operator>>(::string& os) const {
 static void _chroot(::string const& dir) { Trace trace("_chroot",dir) ; int rc = ::chroot(dir.c_str()) ; throw_unless( rc==0 , "cannot chroot to ",dir,rm_slash," : ",StrErr() ) ; }
 static void _chdir (::string const& dir) { Trace trace("_chdir" ,dir) ; int rc = ::chdir (dir.c_str()) ; throw_unless( rc==0 , "cannot chdir to " ,dir,rm_slash," : ",StrErr() ) ; }
 
-// tmpfs is not used, but keep code in case it becomes necessary
-[[maybe_unused]] static void _mount_tmp( ::string const& dst , size_t sz , ::vector<UserTraceEntry>&/*inout*/ user_trace ) { // dst must be dir
+static void _mount_tmp( ::string const& dst , size_t sz , ::vector<UserTraceEntry>&/*inout*/ user_trace ) { // dst must be dir
 	Trace trace("_mount_tmp",dst) ;
 	int rc = ::mount( nullptr/*src*/ , dst.c_str() , "tmpfs" , 0/*flags*/ , cat("size=",sz).c_str() ) ;
 	throw_unless( rc==0 , "cannot mount tmp ",dst,rm_slash," of size ",sz," : ",StrErr() ) ;
 	user_trace.emplace_back( New/*date*/ , Comment::mount , CommentExt::Tmp , no_slash(dst) ) ;
 }
-// size must be large enough but is not allocated
-[[maybe_unused]] static void _mount_tmp( ::string const& dst , ::vector<UserTraceEntry>&/*inout*/ user_trace ) { _mount_tmp( dst , 50<<20/*sz*/ , user_trace ) ; }
+// size must be large enough for namespace templates but is not allocated
+static void _mount_tmp( ::string const& dst , ::vector<UserTraceEntry>&/*inout*/ user_trace ) { _mount_tmp( dst , 50<<20/*sz*/ , user_trace ) ; }
 
 static ::string _mount_chk_dst( ::string const& dst , ::string const& lower_dst_s ) {
 	if (+lower_dst_s) {
@@ -534,6 +590,89 @@ static void _atomic_write( ::string const& file , ::string const& data ) {
 	throw_unless( size_t(cnt)>=data.size() , "cannot write atomically ",data.size()," bytes to ",file," : only ",cnt," bytes written" ) ;
 }
 
+// unshare and setns of a user namespace require the process to be single-threaded, but threads may linger a little while after having been joined (e.g. after washing)
+static void _wait_single_threaded() {
+	static constexpr Delay Tick { 0.0001 } ;
+	for( int i=0 ; i<10000 ; i++ ) {                                           // dont wait forever, unshare will report the error if we are really multi-threaded
+		if (lst_dir_s(::string("/proc/self/task/")).size()<=1) return ;
+		Tick.sleep_for() ;
+	}
+}
+
+// namespace templates
+// when a job space only depends on job attributes (i.e. it has no view inside the repo or the tmp dir), it is prepared once per host and shared by subsequent jobs
+// the template lies in a namespace kept alive by a holder process, which holds a lock on the template dir as long as it lives and exits when template is no more used
+// jobs enter the namespace of the holder, then unshare it so that their own mounts (e.g. their tmp dir) are private
+// chroot dir is built in a tmpfs, so that it disappears with the last job using it and cannot be damaged from outside
+static constexpr time_t TmplIdleTimeout = 600 ; // in s, holder exits when template has not been used for this duration
+static constexpr uint   TmplTick        = 10  ; // in s, holder checks its template is still used at this period
+
+static bool _can_share( ::vmap_s<JobSpace::ViewDescr> const& views , ::string const& tmp_dir_s ) {
+	auto is_private = [&](::string const& d_s) { return is_lcl(d_s) || ( +tmp_dir_s && d_s.starts_with(tmp_dir_s) ) ; } ; // washing or tmp cleaning would damage template mounts
+	for( auto const& [view_s,descr] : views ) {
+		if ( is_private(view_s) || descr.phys_s.size()!=1 ) return false ;                                                    // overlays need a per job work dir
+		if ( is_private(descr.phys_s[0])                  ) return false ;
+	}
+	return true ;
+}
+
+static bool/*entered*/ _enter_tmpl(::string const& tmpl_dir_s) {
+	Trace trace("_enter_tmpl",tmpl_dir_s) ;
+	#ifdef SYS_pidfd_open
+		::string pid_file = tmpl_dir_s+"pid" ;
+		pid_t    pid      = 0                ;
+		try                     { pid = from_string<pid_t>(AcFd(pid_file).read()) ; }
+		catch (::string const&) { trace("no_holder") ; return false ;               }                                       // template is being built
+		AcFd     pid_fd { int(::syscall( SYS_pidfd_open , pid , 0/*flags*/ )) } ; if (!pid_fd) { trace("dead",pid) ; return false ; }
+		::string cwd_s_ = cwd_s()                                                ;                                               // setns moves cwd to root of namespace
+		//         vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+		if ( int rc=::setns( pid_fd , CLONE_NEWUSER|CLONE_NEWNS ) ; rc!=0 ) { trace("no_setns",pid,StrErr()) ; return false ; } // entering both at once ensures we cannot be left half way
+		//         ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+		_chdir(cwd_s_) ;
+		::utimensat( Fd::Cwd , pid_file.c_str() , nullptr/*now*/ , 0/*flags*/ ) ;                                               // tell holder template is still used
+		int rc = ::unshare(CLONE_NEWNS) ; throw_unless( rc==0 , "cannot copy namespace template : ",StrErr() ) ;
+		::mount( nullptr/*src*/ , "/" , nullptr/*type*/ , MS_REC|MS_SLAVE , nullptr/*data*/ ) ;                                 // best effort, ensure our mounts do not propagate to template
+		trace("done",pid) ;
+		return true ;
+	#else
+		return false ;
+	#endif
+}
+
+// holder is detached from job, so it must not prevent anything from terminating
+static void _spawn_tmpl_holder( ::string const& tmpl_dir_s , Fd lock ) {
+	Trace trace("_spawn_tmpl_holder",tmpl_dir_s) ;
+	::string pid_file = tmpl_dir_s+"pid"                ;
+	::string tmp_file = cat(pid_file,'.',::getpid())    ;
+	pid_t    pid      = ::fork()                        ; throw_unless( pid!=-1 , "cannot fork (",StrErr(),") namespace template holder" ) ;
+	if (!pid) {
+		// /!\ it is forbidden to trace here are the trace mapping is shared with parent but pointers will live independently
+		::setsid() ;
+		if ( pid_t holder_pid=::fork() ; holder_pid!=0 ) {                                                                      // in intermediate process, publish holder, which is orphaned
+			if (holder_pid>0)
+				try {
+					AcFd( tmp_file , {.flags=O_WRONLY|O_TRUNC|O_CREAT,.mod=0644} ).write(cat(holder_pid)) ;
+					::rename( tmp_file.c_str() , pid_file.c_str() ) ;                                                           // ensure pid is either absent or complete
+				} catch (::string const&) {}
+			::_exit(0) ;
+		}
+		#if HAS_CLOSE_RANGE
+			::syscall( SYS_close_range , 0u , uint(lock.fd)-1 , 0/*flags*/ ) ;                                                 // keep lock, which tells holder is alive, ...
+			::syscall( SYS_close_range , uint(lock.fd)+1 , ~0u , 0/*flags*/ ) ;                                                // ... but dont hold connections to server and such
+		#else
+			for( int fd : iota(int(::sysconf(_SC_OPEN_MAX))) ) if (fd!=lock.fd) ::close(fd) ;
+		#endif
+		[[maybe_unused]] int rc = ::chdir("/") ;
+		for(;;) {
+			::sleep(TmplTick) ;
+			struct ::stat st ;
+			if ( ::stat(pid_file.c_str(),&st)!=0 || ::time(nullptr)-st.st_mtime>TmplIdleTimeout ) ::_exit(0) ;
+		}
+	}
+	int wstatus ; ::waitpid( pid , &wstatus , 0/*flags*/ ) ;                                                                   // intermediate process exits as soon as holder is published
+	trace("done") ;
+}
+
 void JobSpace::chk() const {
 	if (+lmake_view_s) throw_unless( lmake_view_s.front()=='/' && lmake_view_s.back()=='/'                          , "bad lmake_view" ) ;
 	if (+repo_view_s ) throw_unless( repo_view_s .front()=='/' && repo_view_s .back()=='/' && is_canon(repo_view_s) , "bad repo_view"  ) ;
@@ -624,18 +763,18 @@ void JobSpace::enter(
 ,	SmallId                            small_id
 ,	::string   const&                  phy_lmake_root_s
 ,	::string   const&                  phy_repo_root_s
-,	::string   const&                  phy_tmp_dir_s    , bool keep_tmp
+,	::string   const&                  phy_tmp_dir_s    , bool keep_tmp , size_t tmp_sz
 ,	ChrootInfo const&                  chroot_info
 ,	::string   const&                  sub_repo_s
 ,	::vector_s const&                  src_dirs_s
 ,	bool                               kill_daemons
 ,	bool                               may_mount_in_tmp
 ) {
-	Trace trace("JobSpace::enter",self,small_id,phy_lmake_root_s,phy_repo_root_s,phy_tmp_dir_s,chroot_info,sub_repo_s,src_dirs_s,STR(kill_daemons),STR(may_mount_in_tmp)) ;
+	Trace trace("JobSpace::enter",self,small_id,phy_lmake_root_s,phy_repo_root_s,phy_tmp_dir_s,tmp_sz,chroot_info,sub_repo_s,src_dirs_s,STR(kill_daemons),STR(may_mount_in_tmp)) ;
 	//
 	bool need_chroot = +self || +chroot_info.dir_s ;
 	repo_root_s = repo_view_s | phy_repo_root_s ;
-	if ( !need_chroot && !kill_daemons ) {
+	if ( !need_chroot && !kill_daemons && !tmp_sz ) {
 		if (!keep_tmp) _tmp_dir_s = phy_tmp_dir_s ;
 		trace("not_done",repo_root_s) ;
 		return ;
@@ -672,7 +811,7 @@ void JobSpace::enter(
 	::string const& phy_repo_super_s   = +repo_view_s ? phy_repo_super_s_ : repo_super_s ;                                  // fast path : only compute phy_repo_super_s if necessary
 	::string const& lmake_root_s       = lmake_view_s | phy_lmake_root_s                 ;
 	::string const& tmp_dir_s          = tmp_view_s   | phy_tmp_dir_s                    ;
-	bool            clean_tmp_dir_here = !may_mount_in_tmp                               ;                                  // if job may mount in tmp, we must clean tmp after umount
+	bool            clean_tmp_dir_here = !may_mount_in_tmp && !tmp_sz                    ;                                  // if job may mount in tmp (or tmp is a tmpfs), we must clean tmp after umount
 	//
 	bool bind_lmake =                 +lmake_view_s || +created_files.user_chroot_dir   ;
 	bool bind_repo  =                 +repo_view_s  || +created_files.user_chroot_dir   ;
@@ -713,136 +852,170 @@ void JobSpace::enter(
 	//
 	trace("creat1",STR(_force_creat),STR(bind_lmake),STR(bind_repo),STR(bind_tmp),STR(creat),STR(kill_daemons),uid,gid) ;
 	trace("creat2",lmake_root_s,repo_root_s,tmp_dir_s,repo_super_s                                                    ) ;
-	int unshare_flags = CLONE_NEWUSER | CLONE_NEWNS ; if (kill_daemons) unshare_flags |= CLONE_NEWPID ;
-	//                  vvvvvvvvvvvvvvvvvvvvvvvv
-	int rc            = ::unshare(unshare_flags) ; throw_unless( rc==0 , "cannot create mount namespace : ",StrErr() ) ;
-	//                  ^^^^^^^^^^^^^^^^^^^^^^^^
-	if (kill_daemons) {
-		trace("kill_daemons") ;
-		if ( pid_t pid=::fork() ; pid!=0 ) {                                                    // in parent, /!\ must be first fork() after unshare as this is process 1 in namespace
-			throw_unless( pid!=-1 , "cannot set up to wait (",StrErr(),") for job to finsh" ) ;
-			int   wstatus   ;
-			pid_t child_pid ;
-			do {
-				child_pid = ::wait(&wstatus) ;                                                  // reap orphan if child_pid!=pid
-				if (child_pid==-1) {
-					Fd::Stderr.write(cat("cannot wait (",StrErr(),") for job to finsh")) ;
-					::_exit(+Rc::System) ;                                                      // all the cleanup is done by the child, so nothing to do here
-				}
-			} while (child_pid!=pid) ;
-			::_exit(mimic_wstatus(wstatus)) ;                                                   // all the cleanup is done by the child, so nothing to do here
+	//
+	::string tmpl_dir_s   ;                                                                     // if not empty, job space is shared with other jobs through a namespace template
+	AcFd     tmpl_lock    ;
+	bool     tmpl_entered = false ;
+	_wait_single_threaded() ;
+	if ( need_chroot && !kill_daemons && _can_share(views,tmp_dir_s) ) {                         // template is not in the pid namespace of the job
+		::string key = cat( serialize(self) , serialize(chroot_info) , serialize(src_dirs_s) , serialize(::vector_s({phy_lmake_root_s,phy_repo_root_s})) , creat , bind_tmp ) ;
+		tmpl_dir_s = cat("/tmp/",uid,"/open-lmake/ns/",Crc(New,key).hex(),'/') ;
+		tmpl_lock  = AcFd( tmpl_dir_s+"lock" , {.flags=O_RDWR|O_CREAT,.mod=0600,.err_ok=true} ) ;
+		if      (!tmpl_lock                              ) { trace("no_tmpl"   ,tmpl_dir_s) ; tmpl_dir_s = {} ;                      } // template is only an optimization
+		else if (::flock(tmpl_lock,LOCK_EX|LOCK_NB)==0   ) { trace("build_tmpl",tmpl_dir_s) ; unlnk( tmpl_dir_s+"pid" , {.abs_ok=true} ) ; } // no holder, build template
+		else if (!_enter_tmpl(tmpl_dir_s)                ) { trace("busy_tmpl" ,tmpl_dir_s) ; tmpl_dir_s = {} ; tmpl_lock.close() ;  } // template is being built, dont wait
+		else                                               { trace("use_tmpl"  ,tmpl_dir_s) ; tmpl_entered = true ;                  }
+	}
+	if (tmpl_entered) {
+		created_files.chroot_dir = creat ? tmpl_dir_s+"root" : created_files.user_chroot_dir ;
+	} else {
+		int unshare_flags = CLONE_NEWUSER | CLONE_NEWNS ; if (kill_daemons) unshare_flags |= CLONE_NEWPID ;
+		//                  vvvvvvvvvvvvvvvvvvvvvvvv
+		int rc            = ::unshare(unshare_flags) ; throw_unless( rc==0 , "cannot create mount namespace : ",StrErr() ) ;
+		//                  ^^^^^^^^^^^^^^^^^^^^^^^^
+		if (kill_daemons) {
+			trace("kill_daemons") ;
+			if ( pid_t pid=::fork() ; pid!=0 ) {                                                    // in parent, /!\ must be first fork() after unshare as this is process 1 in namespace
+				throw_unless( pid!=-1 , "cannot set up to wait (",StrErr(),") for job to finsh" ) ;
+				int   wstatus   ;
+				pid_t child_pid ;
+				do {
+					child_pid = ::wait(&wstatus) ;                                                  // reap orphan if child_pid!=pid
+					if (child_pid==-1) {
+						Fd::Stderr.write(cat("cannot wait (",StrErr(),") for job to finsh")) ;
+						::_exit(+Rc::System) ;                                                      // all the cleanup is done by the child, so nothing to do here
+					}
+				} while (child_pid!=pid) ;
+				::_exit(mimic_wstatus(wstatus)) ;                                                   // all the cleanup is done by the child, so nothing to do here
+			}
+			_mount_proc( "/proc" , user_trace ) ;
+			// find a good starting pid
+			// the goal is to minimize risks of pid conflicts between jobs in case pid is used to generate unique filenames as temporary file instead of using TMPDIR, which is quite common
+			// to do that we spread pid's among the availale range by setting the first pid used by jos as apart from each other as possible
+			// call phi the golden number and NPids the number of available pids
+			// spreading is maximized by using phi*NPids as an elementary spacing and id (small_id) as an index modulo NPids
+			// this way there is a conflict between job 1 and job 2 when (id2-id1)*phi is near an integer
+			// because phi is the irrational which is as far from rationals as possible, and id's are as small as possible, this probability is minimized
+			// note that this is over-quality : any more or less random number would do the job : motivation is mathematical beauty rather than practical efficiency
+			static constexpr uint32_t FirstPid = 300                                 ;              // apparently, pid's wrap around back to 300
+			static constexpr uint64_t NPids    = MAX_PID - FirstPid                  ;              // number of available pid's
+			static constexpr uint64_t DeltaPid = (1640531527*NPids) >> n_bits(NPids) ;              // use golden number to ensure best spacing (see above), 1640531527 = (2-(1+sqrt(5))/2)<<32
+			//
+			pid_t first_pid = FirstPid + ((small_id*DeltaPid)>>(32-n_bits(NPids)))%NPids ;          // DeltaPid on 64 bits to avoid rare overflow in multiplication
+			//
+			AcFd( "/proc/sys/kernel/ns_last_pid" , {.flags=O_WRONLY|O_TRUNC} ).write(cat(first_pid)) ;
 		}
-		_mount_proc( "/proc" , user_trace ) ;
-		// find a good starting pid
-		// the goal is to minimize risks of pid conflicts between jobs in case pid is used to generate unique filenames as temporary file instead of using TMPDIR, which is quite common
-		// to do that we spread pid's among the availale range by setting the first pid used by jos as apart from each other as possible
-		// call phi the golden number and NPids the number of available pids
-		// spreading is maximized by using phi*NPids as an elementary spacing and id (small_id) as an index modulo NPids
-		// this way there is a conflict between job 1 and job 2 when (id2-id1)*phi is near an integer
-		// because phi is the irrational which is as far from rationals as possible, and id's are as small as possible, this probability is minimized
-		// note that this is over-quality : any more or less random number would do the job : motivation is mathematical beauty rather than practical efficiency
-		static constexpr uint32_t FirstPid = 300                                 ;              // apparently, pid's wrap around back to 300
-		static constexpr uint64_t NPids    = MAX_PID - FirstPid                  ;              // number of available pid's
-		static constexpr uint64_t DeltaPid = (1640531527*NPids) >> n_bits(NPids) ;              // use golden number to ensure best spacing (see above), 1640531527 = (2-(1+sqrt(5))/2)<<32
+		// mapping uid/gid is necessary to manage overlayfs
+		_atomic_write( "/proc/self/setgroups" , "deny"                  ) ;                         // necessary to be allowed to write to gid_map (cf man 7 user_namespaces)
+		_atomic_write( "/proc/self/uid_map"   , cat(uid,' ',uid," 1\n") ) ;                         // for each line, format is "id_in_namespace id_in_host size_of_range"
+		_atomic_write( "/proc/self/gid_map"   , cat(gid,' ',gid," 1\n") ) ;                         // .
 		//
-		pid_t first_pid = FirstPid + ((small_id*DeltaPid)>>(32-n_bits(NPids)))%NPids ;          // DeltaPid on 64 bits to avoid rare overflow in multiplication
+		if ( tmp_sz && !tmpl_dir_s ) _mount_tmp( phy_tmp_dir_s , tmp_sz , user_trace ) ;            // before tmp dir is bound and views are created in it
 		//
-		AcFd( "/proc/sys/kernel/ns_last_pid" , {.flags=O_WRONLY|O_TRUNC} ).write(cat(first_pid)) ;
-	}
-	// mapping uid/gid is necessary to manage overlayfs
-	_atomic_write( "/proc/self/setgroups" , "deny"                  ) ;                         // necessary to be allowed to write to gid_map (cf man 7 user_namespaces)
-	_atomic_write( "/proc/self/uid_map"   , cat(uid,' ',uid," 1\n") ) ;                         // for each line, format is "id_in_namespace id_in_host size_of_range"
-	_atomic_write( "/proc/self/gid_map"   , cat(gid,' ',gid," 1\n") ) ;                         // .
-	//
-	if (creat) {
-		created_files.chroot_dir = cat("/tmp/",uid,"/open-lmake",phy_repo_root_s,small_id) ;    // /run/user would be ideal instead of /tmp (certain to be usable as upper) but does not always exist
-		mk_dir_empty_s( with_slash(created_files.chroot_dir) , {.abs_ok=true} ) ;
-		if (+created_files.user_chroot_dir) created_files.prepare_user( chroot_info , uid , gid ) ;
-	} else {
-		created_files.chroot_dir = created_files.user_chroot_dir ;
-	}
-	trace("chroot_dir",created_files.chroot_dir) ;
-	//              vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-	if (bind_lmake) created_files.mount_bind_s( lmake_root_s , phy_lmake_root_s , creat ) ;
-	if (bind_repo ) created_files.mount_bind_s( repo_super_s , phy_repo_super_s , creat ) ;
-	if (bind_tmp  ) created_files.mount_bind_s( tmp_dir_s    , phy_tmp_dir_s    , creat ) ;
-	//              ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
-	if (+created_files.chroot_dir) {
-		//                                                         vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-		/**/                                                       created_files.mount_bind_host_s("/dev/" ) ;
-		/**/                                                       created_files.mount_bind_host_s("/proc/") ;
-		/**/                                                       created_files.mount_bind_host_s("/sys/" ) ;
-		for( ::string const& sd_s : src_dirs_s ) if (is_abs(sd_s)) created_files.mount_bind_host_s(sd_s    ) ;
-		//                                                         ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
-	}
-	auto mk_entry = [&]( ::string const& dir_s , ::string const& abs_dir_s , bool path_is_lcl ) {
-		SWEAR( is_dir_name(dir_s) , dir_s ) ;
-		if (path_is_lcl) report.emplace_back(no_slash(dir_s)) ;
-		trace("mkdir",abs_dir_s) ;
-		mk_dir_s(abs_dir_s) ;
-	} ;
-	//
-	size_t work_idx = 0 ;
-	for( auto const& [view_s,descr] : views ) {
-		bool       view_is_tmp = +tmp_dir_s && view_s.starts_with(tmp_dir_s)                                                ;
-		bool       view_is_lcl = is_lcl(view_s)                                                                             ;
-		bool       view_is_ext = !view_is_lcl && !view_is_tmp                                                               ;
-		::string   lcl_view_s  = view_is_tmp ? tmp_view_s+substr_view(view_s,tmp_dir_s.size()) : mk_glb(view_s,repo_root_s) ;
-		::string   abs_view_s  = created_files.chroot_dir + lcl_view_s                                                      ;
-		::vector_s abs_phys_s  ;
-		::vector_s abs_cu_dsts ;
+		if ( creat && +tmpl_dir_s ) {
+			created_files.chroot_dir = tmpl_dir_s+"root" ;                                          // template dir is only a mount point, it need not be cleaned
+			mk_dir_s( with_slash(created_files.chroot_dir) ) ;
+			_mount_tmp( created_files.chroot_dir , user_trace ) ;
+			if (+created_files.user_chroot_dir) created_files.prepare_user( chroot_info , uid , gid ) ;
+		} else if (creat) {
+			created_files.chroot_dir = cat("/tmp/",uid,"/open-lmake",phy_repo_root_s,small_id) ;    // /run/user would be ideal instead of /tmp (certain to be usable as upper) but does not always exist
+			mk_dir_empty_s( with_slash(created_files.chroot_dir) , {.abs_ok=true} ) ;
+			if (+created_files.user_chroot_dir) created_files.prepare_user( chroot_info , uid , gid ) ;
+		} else {
+			created_files.chroot_dir = created_files.user_chroot_dir ;
+		}
+		trace("chroot_dir",created_files.chroot_dir) ;
+		//                              vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+		if ( bind_lmake               ) created_files.mount_bind_s( lmake_root_s , phy_lmake_root_s , creat ) ;
+		if ( bind_repo                ) created_files.mount_bind_s( repo_super_s , phy_repo_super_s , creat ) ;
+		if ( bind_tmp  && !tmpl_dir_s ) created_files.mount_bind_s( tmp_dir_s    , phy_tmp_dir_s    , creat ) ;
+		//                              ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+		if ( bind_tmp && +tmpl_dir_s && creat ) created_files.creat_dir_s(tmp_dir_s) ;             // tmp dir is per job, it is bound once template is published
+		if (+created_files.chroot_dir) {
+			//                                                         vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+			/**/                                                       created_files.mount_bind_host_s("/dev/" ) ;
+			/**/                                                       created_files.mount_bind_host_s("/proc/") ;
+			/**/                                                       created_files.mount_bind_host_s("/sys/" ) ;
+			for( ::string const& sd_s : src_dirs_s ) if (is_abs(sd_s)) created_files.mount_bind_host_s(sd_s    ) ;
+			//                                                         ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+		}
+		auto mk_entry = [&]( ::string const& dir_s , ::string const& abs_dir_s , bool path_is_lcl ) {
+			SWEAR( is_dir_name(dir_s) , dir_s ) ;
+			if (path_is_lcl) report.emplace_back(no_slash(dir_s)) ;
+			trace("mkdir",abs_dir_s) ;
+			mk_dir_s(abs_dir_s) ;
+		} ;
 		//
-		for( size_t i : iota(descr.phys_s.size()) ) {
-			::string const& phy_s      = descr.phys_s[i]                                                                                ;
-			bool            phy_is_tmp = +tmp_dir_s && phy_s.starts_with(tmp_dir_s)                                                     ;
-			bool            phy_is_lcl = is_lcl(phy_s) && +phy_s                                                                        ;
-			bool            phy_is_ext = !phy_is_lcl && !phy_is_tmp                                                                     ;
-			::string        abs_phy_s  = phy_is_tmp ? phy_tmp_dir_s+substr_view(phy_s,tmp_dir_s.size()) : mk_glb(phy_s,phy_repo_root_s) ;
+		size_t work_idx = 0 ;
+		for( auto const& [view_s,descr] : views ) {
+			bool       view_is_tmp = +tmp_dir_s && view_s.starts_with(tmp_dir_s)                                                ;
+			bool       view_is_lcl = is_lcl(view_s)                                                                             ;
+			bool       view_is_ext = !view_is_lcl && !view_is_tmp                                                               ;
+			::string   lcl_view_s  = view_is_tmp ? tmp_view_s+substr_view(view_s,tmp_dir_s.size()) : mk_glb(view_s,repo_root_s) ;
+			::string   abs_view_s  = created_files.chroot_dir + lcl_view_s                                                      ;
+			::vector_s abs_phys_s  ;
+			::vector_s abs_cu_dsts ;
 			//
-			if (!phy_is_ext) {
-				mk_entry( phy_s , abs_phy_s , phy_is_lcl ) ;
-			} else {
-				FileTag tag = FileInfo(abs_phy_s).tag() ;
-				if (tag!=FileTag::Dir) throw cat("cannot map ",no_slash(view_s)," to non-existent ",no_slash(phy_s)) ;
-			}
-			abs_phys_s.push_back(abs_phy_s) ;
-			if (i==0) {
-				if      (phy_is_ext    ) SWEAR(descr.phys_s.size()==1) ;                        // else dont know where to create the work dir which must be on the same filesystem as upper
-				else if (+descr.copy_up)                                                        // prepare copy up destination in upper
-					for( ::string const& cu  : descr.copy_up ) {
-						if (is_dir_name(cu)) {                               mk_entry(phy_s+cu ,abs_phy_s+cu ,phy_is_lcl) ; abs_cu_dsts.push_back({}          ) ; } // for dirs, just create it
-						else                 { ::string cud=dir_name_s(cu) ; mk_entry(phy_s+cud,abs_phy_s+cud,phy_is_lcl) ; abs_cu_dsts.push_back(abs_phy_s+cu) ; }
+			for( size_t i : iota(descr.phys_s.size()) ) {
+				::string const& phy_s      = descr.phys_s[i]                                                                                ;
+				bool            phy_is_tmp = +tmp_dir_s && phy_s.starts_with(tmp_dir_s)                                                     ;
+				bool            phy_is_lcl = is_lcl(phy_s) && +phy_s                                                                        ;
+				bool            phy_is_ext = !phy_is_lcl && !phy_is_tmp                                                                     ;
+				::string        abs_phy_s  = phy_is_tmp ? phy_tmp_dir_s+substr_view(phy_s,tmp_dir_s.size()) : mk_glb(phy_s,phy_repo_root_s) ;
+				//
+				if (!phy_is_ext) {
+					mk_entry( phy_s , abs_phy_s , phy_is_lcl ) ;
+				} else {
+					FileTag tag = FileInfo(abs_phy_s).tag() ;
+					if (tag!=FileTag::Dir) throw cat("cannot map ",no_slash(view_s)," to non-existent ",no_slash(phy_s)) ;
+				}
+				abs_phys_s.push_back(abs_phy_s) ;
+				if (i==0) {
+					if      (phy_is_ext    ) SWEAR(descr.phys_s.size()==1) ;                        // else dont know where to create the work dir which must be on the same filesystem as upper
+					else if (+descr.copy_up)                                                        // prepare copy up destination in upper
+						for( ::string const& cu  : descr.copy_up ) {
+							if (is_dir_name(cu)) {                               mk_entry(phy_s+cu ,abs_phy_s+cu ,phy_is_lcl) ; abs_cu_dsts.push_back({}          ) ; } // for dirs, just create it
+							else                 { ::string cud=dir_name_s(cu) ; mk_entry(phy_s+cud,abs_phy_s+cud,phy_is_lcl) ; abs_cu_dsts.push_back(abs_phy_s+cu) ; }
+						}
+				} else {
+					if (+abs_cu_dsts) {                                                                         // try to copy up remaining destinations
+						SWEAR( descr.copy_up.size()==abs_cu_dsts.size() , descr.copy_up,abs_cu_dsts ) ;
+						for ( size_t j : iota(descr.copy_up.size()) )
+							if ( +abs_cu_dsts[j] && +cpy( abs_phy_s+descr.copy_up[j] , abs_cu_dsts[j] ) )
+								abs_cu_dsts[j] = {} ;                                                           // copy is done from this lower, dont try following lowers
 					}
-			} else {
-				if (+abs_cu_dsts) {                                                                         // try to copy up remaining destinations
-					SWEAR( descr.copy_up.size()==abs_cu_dsts.size() , descr.copy_up,abs_cu_dsts ) ;
-					for ( size_t j : iota(descr.copy_up.size()) )
-						if ( +abs_cu_dsts[j] && +cpy( abs_phy_s+descr.copy_up[j] , abs_cu_dsts[j] ) )
-							abs_cu_dsts[j] = {} ;                                                           // copy is done from this lower, dont try following lowers
 				}
 			}
+			//
+			if (view_is_ext) created_files.creat_dir_s( view_s                            ) ;
+			else             mk_entry                 ( view_s , abs_view_s , view_is_lcl ) ;                   // external views are created above
+			//
+			if ( view_is_tmp && !keep_tmp ) swear_prod( !clean_tmp_dir_here , abs_view_s ) ;                    // ensure we do not clean up dirs mounted tmp upon exit
+			if (abs_phys_s.size()==1) {
+				//vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+				_mount_bind( abs_view_s , abs_phys_s[0] , user_trace , created_files.user_chroot_dir+lcl_view_s ) ;
+				//^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+			} else {
+				::string const& upper_s = descr.phys_s[0] ;
+				::string        work_s  =                                                                       // if not in the repo, it must be in tmp
+					is_lcl(upper_s) ? cat(phy_repo_root_s,PrivateAdminDirS,"work/",small_id,'.',work_idx++,'/')
+					:                 cat(no_slash(abs_phys_s[0])         ,".work."            ,work_idx++,'/') // upper is in tmp (there may be several views to same upper)
+				;
+				//vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+				_mount_overlay( abs_view_s , abs_phys_s , work_s , user_trace , created_files.user_chroot_dir+lcl_view_s ) ;
+				//^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+			}
 		}
-		//
-		if (view_is_ext) created_files.creat_dir_s( view_s                            ) ;
-		else             mk_entry                 ( view_s , abs_view_s , view_is_lcl ) ;                   // external views are created above
-		//
-		if ( view_is_tmp && !keep_tmp ) swear_prod( !clean_tmp_dir_here , abs_view_s ) ;                    // ensure we do not clean up dirs mounted tmp upon exit
-		if (abs_phys_s.size()==1) {
-			//vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-			_mount_bind( abs_view_s , abs_phys_s[0] , user_trace , created_files.user_chroot_dir+lcl_view_s ) ;
-			//^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
-		} else {
-			::string const& upper_s = descr.phys_s[0] ;
-			::string        work_s  =                                                                       // if not in the repo, it must be in tmp
-				is_lcl(upper_s) ? cat(phy_repo_root_s,PrivateAdminDirS,"work/",small_id,'.',work_idx++,'/')
-				:                 cat(no_slash(abs_phys_s[0])         ,".work."            ,work_idx++,'/') // upper is in tmp (there may be several views to same upper)
-			;
-			//vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-			_mount_overlay( abs_view_s , abs_phys_s , work_s , user_trace , created_files.user_chroot_dir+lcl_view_s ) ;
-			//^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+		if (creat) created_files.fill() ;
+		if (+tmpl_dir_s) {
+			try                       { _spawn_tmpl_holder( tmpl_dir_s , tmpl_lock ) ;  }              // publish template before anything specific to this job is mounted
+			catch (::string const& e) { trace("no_holder",e) ;                          }              // template is only an optimization
+			int rc = ::unshare(CLONE_NEWNS) ; throw_unless( rc==0 , "cannot copy namespace template : ",StrErr() ) ;
+			::mount( nullptr/*src*/ , "/" , nullptr/*type*/ , MS_REC|MS_SLAVE , nullptr/*data*/ ) ;     // best effort, ensure our mounts do not propagate to template
 		}
 	}
-	if (creat) created_files.fill() ;
+	if ( tmp_sz   && +tmpl_dir_s ) _mount_tmp                 ( phy_tmp_dir_s , tmp_sz , user_trace  ) ; // tmpfs is private to job, it must not be part of template
+	if ( bind_tmp && +tmpl_dir_s ) created_files.mount_bind_s( tmp_dir_s     , phy_tmp_dir_s , creat ) ;
 	if (+created_files.chroot_dir) {
 		//vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 		_chroot(created_files.chroot_dir) ;
@@ -857,7 +1030,7 @@ void JobSpace::enter(
 	}
 	// only set _tmp_dir_s once tmp mount and chroot are done so as to ensure not to unlink in the underlying dir
 	if ( clean_tmp_dir_here && !keep_tmp ) _tmp_dir_s = tmp_dir_s ;                                         // if we have mounted something in tmp, we cant clean it before unmount
-	user_trace.emplace_back( New/*date*/ , Comment::EnteredNamespace ) ;
+	user_trace.emplace_back( New/*date*/ , Comment::EnteredNamespace , CommentExts() , no_slash(tmpl_dir_s) ) ;
 	trace("done",report) ;
 }
 
@@ -1128,6 +1301,9 @@ void JobEndRpcReq::chk(bool for_cache) const {
 void JobStartRpcReply::operator>>(::string& os) const {        // START_OF_NO_COV
 	/**/                   os << "JobStartRpcReply("<<rule   ;
 	/**/                   os << ','<<autodep_env            ;
+	if (+cgroup_s        ) os << ",cgroup:"<<cgroup_s        ;
+	if ( cgroup_mem      ) os << ",mem:"<<cgroup_mem         ;
+	if ( cgroup_cpu      ) os << ",cpu:"<<cgroup_cpu         ;
 	if (+job_space       ) os << ','<<job_space              ;
 	if ( keep_tmp        ) os << ','<<"keep"                 ;
 	if (+ddate_prec      ) os << ','<<ddate_prec             ;
@@ -1141,12 +1317,15 @@ void JobStartRpcReply::operator>>(::string& os) const {        // START_OF_NO_CO
 	/**/                   os << ','<<method                 ;
 	if (+network_delay   ) os << ','<<network_delay          ;
 	if (+pre_actions     ) os << ','<<pre_actions            ;
+	if (+relay           ) os << ",relay:"<<relay            ;
 	/**/                   os << ','<<small_id               ;
 	if (+star_matches    ) os << ','<<star_matches           ;
 	if (+static_matches  ) os << '>'<<static_matches         ;
 	if (+stdin           ) os << '<'<<stdin                  ;
 	if (+stdout          ) os << '>'<<stdout                 ;
 	if (+timeout         ) os << ','<<timeout                ;
+	if ( tmp_sz          ) os << ",tmp_fs:"<<tmp_sz          ;
+	if ( watch_deps      ) os << ','<<"watch_deps"           ;
 	/**/                   os << ','<<cmd                    ; // last as it is most probably multi-line
 	/**/                   os << ')'                         ;
 }                                                              // END_OF_NO_COV
@@ -1215,6 +1394,7 @@ void JobStartRpcReply::enter(
 	mk_lmake_version() ;
 	//
 	if (!phy_lmake_root_s) phy_lmake_root_s = dflt_lmake_root_s ;
+	if (keep_tmp         ) tmp_sz           = 0                 ; // tmpfs content would be lost
 	//
 	autodep_env.repo_root_s = job_space.repo_view_s | phy_repo_root_s ;
 	autodep_env.tmp_dir_s   = job_space.tmp_view_s  | phy_tmp_dir_s   ;
@@ -1236,7 +1416,7 @@ void JobStartRpcReply::enter(
 	,	         small_id
 	,	         phy_lmake_root_s
 	,	         phy_repo_root_s
-	,	         phy_tmp_dir_s               , keep_tmp
+	,	         phy_tmp_dir_s               , keep_tmp , tmp_sz
 	,	         chroot_info
 	,	         autodep_env.sub_repo_s
 	,	         autodep_env.src_dirs_s
@@ -1317,10 +1497,15 @@ void JobStartRpcReply::exit() {
 void JobStartRpcReply::cache_cleanup() {
 	autodep_env.fast_report_pipe = {}    ; // execution dependent
 	cache                        = {}    ; // no recursive info
-	key                          = {}    ; // .
+	cgroup_s                     = {}    ; // execution dependent
+	cgroup_mem                   = 0     ; // .
+	cgroup_cpu                   = 0     ; // .
+	key                          = {}    ; // no recursive info
 	live_out                     = false ; // execution dependent
 	nice                         = -1    ; // .
 	pre_actions                  = {}    ; // .
+	tmp_sz                       = 0     ; // .
+	watch_deps                   = false ; // .
 }
 
 void JobStartRpcReply::chk(bool for_cache) const {
@@ -1336,10 +1521,13 @@ void JobStartRpcReply::chk(bool for_cache) const {
 	/**/                                      throw_unless( timeout>=Delay()                                              , "bad timeout"           ,timeout.short_str()       ) ;
 	if (for_cache) {
 		throw_unless( !cache             , "bad cache"       ) ;
+		throw_unless( !cgroup_s          , "bad cgroup"      ) ;
 		throw_unless( !key               , "bad key"         ) ;
 		throw_unless( !live_out          , "bad live_out"    ) ;
 		throw_unless(  nice==uint8_t(-1) , "bad nice"        ) ;
 		throw_unless( !pre_actions       , "bad pre_actions" ) ;
+		throw_unless( !tmp_sz            , "bad tmp_sz"      ) ;
+		throw_unless( !watch_deps        , "bad watch_deps"  ) ;
 	}
 }
 
@@ -1356,6 +1544,42 @@ void JobMngtRpcReq::operator>>(::string& os) const {                    // START
 	/**/          os << ')'                                           ;
 }                                                                       // END_OF_NO_COV
 
+//
+// JobRelayRpcReq
+//
+
+void JobRelayRpcReq::operator>>(::string& os) const { // START_OF_NO_COV
+	/**/        os << "JobRelayRpcReq(" ;
+	if (is_end) os << end               ;
+	else        os << mngt              ;
+	/**/        os << ')'               ;
+}                                                     // END_OF_NO_COV
+
+::pair<::sockaddr_un,socklen_t> relay_sock_addr(KeyedService const& relay) {
+	::string      name = cat("lmake_relay-",relay.str())         ; // service contains addr, port and key, hence identifies server
+	::sockaddr_un addr = { .sun_family=AF_UNIX , .sun_path={} } ;
+	SWEAR( 1+name.size()<=sizeof(addr.sun_path) , name ) ;
+	::memcpy( addr.sun_path+1 , name.data() , name.size() ) ;      // leading \0 means abstract socket, which needs no cleanup
+	return { addr , offsetof(::sockaddr_un,sun_path)+1+name.size() } ;
+}
+
+AcFd relay_connect(KeyedService const& relay) {
+	auto [addr,len] = relay_sock_addr(relay)                             ;
+	AcFd fd         = ::socket( AF_UNIX , SOCK_STREAM|SOCK_CLOEXEC , 0 ) ; if (!fd) return {} ;
+	if (::connect( fd , reinterpret_cast<::sockaddr const*>(&addr) , len )!=0) return {} ;
+	return fd ;
+}
+
+bool/*sent*/ send_to_relay( KeyedService const& relay , bool is_end , ::string const& serialized ) {
+	AcFd    fd  = relay_connect(relay) ; if (!fd) return false ;
+	OMsgBuf msg ;
+	msg.add_serialized( serialize(is_end)+serialized ) ;           // same layout as JobRelayRpcReq, without copying message
+	try                     { msg.send( fd , {}/*key*/ ) ; }
+	catch (::string const&) { return false ;               }
+	char ack ;
+	return ::read(fd,&ack,1)==1 ;                                  // relay acknowledges once message is forwarded to server
+}
+
 //
 // JobMngtRpcReply
 //
@@ -1365,6 +1589,7 @@ void JobMngtRpcReply::operator>>(::string& os) const {                // START_O
 	if (+fd           ) os << ','<<fd                               ;
 	if (+verbose_infos) os << ','<<verbose_infos                    ;
 	if (+txt          ) os << ','<<txt                              ;
+	if ( sig          ) os << ",sig:"<<sig                          ;
 	/**/                os << ','<<ok                               ;
 	/**/                os << ')'                                   ;
 }                                                                     // END_OF_NO_COV
@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include <sys/un.h>
+
 #include "disk.hh"
 #include "hash.hh"
 #include "re.hh"
@@ -122,6 +124,7 @@ enum class JobMngtProc : uint8_t {
 ,	AddLiveOut // report missing live_out info (Req) or tell job_exec to send missing live_out info (Reply)
 ,	Heartbeat
 ,	Kill
+,	Suspend    // used in JobMngtRpcReply to signal job is waiting for direct deps and its resources are released
 } ;
 // END_OF_VERSIONING
 
@@ -438,9 +441,12 @@ struct JobReason {
 
 struct JobStats {
 	// START_OF_VERSIONING REPO CACHE
-	size_t            mem = 0  ; // in bytes
-	Time::CoarseDelay cpu = {} ;
-	Time::CoarseDelay job = {} ; // elapsed in job
+	size_t            mem      = 0  ; // in bytes
+	Time::CoarseDelay cpu      = {} ;
+	Time::CoarseDelay job      = {} ; // elapsed in job
+	size_t            io_read  = 0  ; // in bytes, read    from block devices
+	size_t            io_write = 0  ; // in bytes, written to   block devices
+	size_t            tmp      = 0  ; // in bytes, used in tmp dir at end of job, only measured when tmp dir is a tmpfs
 	// END_OF_VERSIONING
 } ;
 
@@ -785,7 +791,7 @@ struct JobSpace {
 	,	SmallId
 	,	::string   const&                  phy_lmake_root_s
 	,	::string   const&                  phy_repo_root_s
-	,	::string   const&                  phy_tmp_dir_s    , bool keep_tmp
+	,	::string   const&                  phy_tmp_dir_s    , bool keep_tmp , size_t tmp_sz
 	,	ChrootInfo const&                  chroot_info
 	,	::string   const&                  sub_repo_s
 	,	::vector_s const&                  src_dirs_s
@@ -882,6 +888,8 @@ struct JobStartRpcReply {                                      // NOLINT(clang-a
 	template<IsStream S> void serdes(S& s) {
 		::serdes( s , autodep_env                       ) ;
 		::serdes( s , cache                             ) ;
+		::serdes( s , cgroup_s         , cgroup_mem     ) ;
+		::serdes( s , cgroup_cpu                        ) ;
 		::serdes( s , chk_abs_paths                     ) ;
 		::serdes( s , chroot_info                       ) ;
 		::serdes( s , cmd                               ) ;
@@ -900,13 +908,16 @@ struct JobStartRpcReply {                                      // NOLINT(clang-a
 		::serdes( s , nice                              ) ;
 		::serdes( s , phy_lmake_root_s                  ) ;
 		::serdes( s , pre_actions                       ) ;
+		::serdes( s , relay                             ) ;
 		::serdes( s , rule                              ) ;
 		::serdes( s , small_id                          ) ;
 		::serdes( s , star_matches     , static_matches ) ;
 		::serdes( s , stderr_ok                         ) ;
 		::serdes( s , stdin            , stdout         ) ;
 		::serdes( s , timeout                           ) ;
+		::serdes( s , tmp_sz                            ) ;
 		::serdes( s , use_script                        ) ;
+		::serdes( s , watch_deps                        ) ;
 		::serdes( s , zlvl                              ) ;
 	}
 	void mk_canon( ::string const& phy_repo_root_s ) ;
@@ -928,6 +939,9 @@ struct JobStartRpcReply {                                      // NOLINT(clang-a
 	// START_OF_VERSIONING REPO CACHE
 	AutodepEnv                              autodep_env      ;
 	CacheRemoteSide                         cache            ;
+	::string                                cgroup_s         ;                       // if non-empty, cgroup v2 dir under which a per-job cgroup is created
+	size_t                                  cgroup_mem       = 0                   ; // in bytes, memory job is limited to within its cgroup, 0 means no limit
+	uint32_t                                cgroup_cpu       = 0                   ; // number of cpus job is throttled to within its cgroup, 0 means no limit
 	bool                                    chk_abs_paths    = false               ;
 	ChrootInfo                              chroot_info      ;
 	::string                                cmd              ;
@@ -946,6 +960,7 @@ struct JobStartRpcReply {                                      // NOLINT(clang-a
 	uint8_t                                 nice             = 0                   ;
 	::string                                phy_lmake_root_s ;
 	::vmap_s<FileAction>                    pre_actions      ;
+	KeyedService                            relay            ;                       // if non-empty, server service to which per-host relay connects (addr is server addr as seen by job)
 	::string                                rule             ;                       // rule name
 	SmallId                                 small_id         = 0                   ;
 	::vmap<Re::Pattern,MatchFlags>          star_matches     ;                       // maps regexprs to flags
@@ -954,7 +969,9 @@ struct JobStartRpcReply {                                      // NOLINT(clang-a
 	::string                                stdin            ;
 	::string                                stdout           ;
 	Time::Delay                             timeout          ;
+	size_t                                  tmp_sz           = 0                   ; // in bytes, if non-zero, tmp dir is a tmpfs of this size
 	bool                                    use_script       = false               ;
+	bool                                    watch_deps       = false               ; // if true, job is killed and rerun as soon as a dep it has read is modified
 	Zlvl                                    zlvl             {}                    ;
 	// END_OF_VERSIONING
 	LmakeVersion lmake_version ;                                                     // not transported
@@ -1036,6 +1053,30 @@ struct JobMngtRpcReq : JobRpcReq {
 	::string               txt     = {}         ;                                                              // proc==LiveOut
 } ;
 
+// messages sent to server through a per-host relay, which forwards them over a single persistent connection
+// layout is a bool followed by the message, so that it can be built by simply concatenating serialized data
+struct JobRelayRpcReq {
+	// accesses
+	void operator>>(::string&) const ;
+	bool operator+ (         ) const { return is_end ? +end : +mngt ; }
+	// services
+	template<IsStream S> void serdes(S& s) {
+		::serdes( s , is_end ) ;
+		if (is_end) ::serdes( s , end  ) ;
+		else        ::serdes( s , mngt ) ;
+	}
+	// data
+	bool          is_end = false ;
+	JobMngtRpcReq mngt   ;         // if !is_end
+	JobEndRpcReq  end    ;         // if  is_end
+} ;
+
+// per-host relay (job_exec --relay) listens to an abstract unix socket whose name is derived from the server service it forwards to
+// it acknowledges each message with a single byte once forwarded to server, so that job can fall back to a direct connection in case of failure
+::pair<::sockaddr_un,socklen_t> relay_sock_addr( KeyedService const& relay                                              ) ;
+AcFd                            relay_connect  ( KeyedService const& relay                                              ) ; // return empty if relay is not running
+bool/*sent*/                    send_to_relay  ( KeyedService const& relay , bool is_end , ::string const& serialized ) ; // serialized is the serialized JobMngtRpcReq or JobEndRpcReq
+
 struct JobMngtRpcReply {
 	using Crc  = Hash::Crc   ;
 	using Proc = JobMngtProc ;
@@ -1054,6 +1095,7 @@ struct JobMngtRpcReply {
 			case Proc::DepVerbose : ::serdes( s , fd , verbose_infos ) ; break ;
 			case Proc::ChkDeps    :
 			case Proc::ChkTargets : ::serdes( s , fd , ok , txt      ) ; break ;
+			case Proc::Suspend    : ::serdes( s , sig                ) ; break ;
 		DF}                                                                      // NO_COV
 	}
 	// data
@@ -1063,4 +1105,5 @@ struct JobMngtRpcReply {
 	::vector<VerboseInfo> verbose_infos = {}    ;                                // proc ==                   DepVerbose
 	::string              txt           = {}    ;                                // proc == ChkDeps|                     , reason for ChkDeps
 	Bool3                 ok            = Maybe ;                                // proc == ChkDeps|DepDirect            , if No <=> deps in error, if Maybe <=> deps not ready
+	int                   sig           = 0     ;                                // proc ==                   Suspend    , signal to send to job (0 if none)
 } ;
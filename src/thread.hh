@@ -232,7 +232,9 @@ enum class ServerThreadEventKind : uint8_t {
 ,	Slave
 ,	Stop
 } ;
-template<class T,bool Flush=true> struct ServerThread {                                          // if Flush, finish on going connections
+// if Flush, finish on going connections
+// if Persistent, connections may carry several messages (e.g. from a relay) and are only closed upon eof, else a connection carries a single message
+template<class T,bool Flush=true,bool Persistent=false> struct ServerThread {
 	using EventKind = ServerThreadEventKind ;
 private :
 	static void _s_thread_func( ::stop_token stop , char key , ServerThread* this_ , ::function<void(::stop_token,T&&,Fd)> func ) {
@@ -296,6 +298,19 @@ private :
 							else    trace("eof"        ) ;
 							goto Close ;
 						}
+						if constexpr (Persistent) {
+							while (+*r) {
+								//vvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+								func( stop , ::move(*r) , efd ) ;
+								//^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+								trace("called") ;
+								try                       { r = it->second.buf.template receive_step<T>( efd , No/*fetch*/ , it->second.key ) ; } // process messages already received
+								catch (::string const& e) { trace("malformed",e) ; goto Close ;                                                   }
+								if (!r) break ;
+							}
+							if (+r) { trace("eof") ; goto Close ; }
+							continue ;
+						}
 						//vvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 						func( stop , ::move(*r) , efd ) ;
 						//^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
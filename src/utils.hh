@@ -74,6 +74,7 @@ enum class MutexLvl : uint8_t { // identify who is owning the current level to e
 	Unlocked                    // used in Lock to identify when not locked
 ,	None
 // level 1
+,	Cache                       // lcache_server store
 ,	JobExec
 ,	StartJob
 // level 2
@@ -1,15 +1,15 @@
 #include "version.hh"
 namespace Version {
-	uint64_t    constexpr Cache = 51      ; // 9d27790ef49ea8b65b53719237102c70
+	uint64_t    constexpr Cache = 57      ; // 7cf50fe64e7628beddfd2c0ca11fdfbc
 	uint64_t    constexpr Codec = 3       ; // 7319fd9fdc817eb270477875338dd334
-	uint64_t    constexpr Repo  = 55      ; // 5e0d6d5628232ff0b7cb8e58a1ee9066
+	uint64_t    constexpr Repo  = 62      ; // b8d972d565c0384a96cba5ec33ef61cb
 	uint64_t    constexpr Job   = 27      ; // ca18f7fe16e63be4e49d3dd4bd94ba08
 	const char* const     Major = "26.07" ;
 	uint64_t    constexpr Tag   = 0       ;
 }
 
 // ********************************************
-// * Cache : 9d27790ef49ea8b65b53719237102c70 *
+// * Cache : 7cf50fe64e7628beddfd2c0ca11fdfbc *
 // ********************************************
 //
 //	// START_OF_VERSIONING CACHE REPO JOB
@@ -344,6 +344,7 @@ namespace Version {
 //			::vmap_ss        rsrcs        = {} ;
 //			JobStartRpcReq   pre_start    = {} ;
 //			JobStartRpcReply start        = {} ;
+//			::string         placement    = {} ; // cpus and memory nodes job was bound to by backend, if any
 //			// END_OF_VERSIONING
 //			// START_OF_VERSIONING REPO CACHE
 //			JobInfoStart                            start    ;
@@ -496,6 +497,7 @@ namespace Version {
 //	,	AddLiveOut // report missing live_out info (Req) or tell job_exec to send missing live_out info (Reply)
 //	,	Heartbeat
 //	,	Kill
+//	,	Suspend    // used in JobMngtRpcReply to signal job is waiting for direct deps and its resources are released
 //	} ;
 //	// END_OF_VERSIONING
 //	// START_OF_VERSIONING REPO CACHE
@@ -608,9 +610,12 @@ namespace Version {
 //		Tag     tag  = JobReasonTag::None ;
 //		// END_OF_VERSIONING
 //		// START_OF_VERSIONING REPO CACHE
-//		size_t            mem = 0  ; // in bytes
-//		Time::CoarseDelay cpu = {} ;
-//		Time::CoarseDelay job = {} ; // elapsed in job
+//		size_t            mem      = 0  ; // in bytes
+//		Time::CoarseDelay cpu      = {} ;
+//		Time::CoarseDelay job      = {} ; // elapsed in job
+//		size_t            io_read  = 0  ; // in bytes, read    from block devices
+//		size_t            io_write = 0  ; // in bytes, written to   block devices
+//		size_t            tmp      = 0  ; // in bytes, used in tmp dir at end of job, only measured when tmp dir is a tmpfs
 //		// END_OF_VERSIONING
 //		// START_OF_VERSIONING REPO CACHE
 //		using Base = ::variant< Hash::Crc , Disk::FileSig , Disk::FileInfo > ;
@@ -674,6 +679,9 @@ namespace Version {
 //		// START_OF_VERSIONING REPO CACHE
 //		AutodepEnv                              autodep_env      ;
 //		CacheRemoteSide                         cache            ;
+//		::string                                cgroup_s         ;                       // if non-empty, cgroup v2 dir under which a per-job cgroup is created
+//		size_t                                  cgroup_mem       = 0                   ; // in bytes, memory job is limited to within its cgroup, 0 means no limit
+//		uint32_t                                cgroup_cpu       = 0                   ; // number of cpus job is throttled to within its cgroup, 0 means no limit
 //		bool                                    chk_abs_paths    = false               ;
 //		ChrootInfo                              chroot_info      ;
 //		::string                                cmd              ;
@@ -692,6 +700,7 @@ namespace Version {
 //		uint8_t                                 nice             = 0                   ;
 //		::string                                phy_lmake_root_s ;
 //		::vmap_s<FileAction>                    pre_actions      ;
+//		KeyedService                            relay            ;                       // if non-empty, server service to which per-host relay connects (addr is server addr as seen by job)
 //		::string                                rule             ;                       // rule name
 //		SmallId                                 small_id         = 0                   ;
 //		::vmap<Re::Pattern,MatchFlags>          star_matches     ;                       // maps regexprs to flags
@@ -700,7 +709,9 @@ namespace Version {
 //		::string                                stdin            ;
 //		::string                                stdout           ;
 //		Time::Delay                             timeout          ;
+//		size_t                                  tmp_sz           = 0                   ; // in bytes, if non-zero, tmp dir is a tmpfs of this size
 //		bool                                    use_script       = false               ;
+//		bool                                    watch_deps       = false               ; // if true, job is killed and rerun as soon as a dep it has read is modified
 //		Zlvl                                    zlvl             {}                    ;
 //		// END_OF_VERSIONING
 //		// START_OF_VERSIONING REPO CACHE
@@ -1118,7 +1129,7 @@ namespace Version {
 //		// END_OF_VERSIONING
 
 // *******************************************
-// * Repo : 5e0d6d5628232ff0b7cb8e58a1ee9066 *
+// * Repo : b8d972d565c0384a96cba5ec33ef61cb *
 // *******************************************
 //
 //	// START_OF_VERSIONING CACHE REPO JOB
@@ -1433,10 +1444,15 @@ namespace Version {
 //				bool     show_ete     = true  ;
 //				// END_OF_VERSIONING
 //			// START_OF_VERSIONING REPO
+//			::string                                                                cgroup_s            ;         // if non-empty, cgroup v2 dir under which jobs are run, each in its own sub-cgroup
 //			FileSync                                                                file_sync           = {}    ; // method to ensure file sync when over an unreliable filesystem such as NFS
+//			bool                                                                    job_relay           = false ; // if true, remote jobs report to server through a per-host relay
 //			size_t                                                                  max_err_lines       = 0     ; // unlimited
 //			uint8_t                                                                 nice                = 0     ; // nice value applied to jobs
+//			bool                                                                    predict_rsrcs       = false ; // if true, jobs are submitted with cpu & mem predicted from history
 //			FileSync                                                                server_file_sync    = {}    ; // method to use on server side
+//			bool                                                                    tmp_fs              = false ; // if true, tmp dir of jobs declaring a tmp resource is a tmpfs of that size
+//			bool                                                                    watch_deps          = false ; // if true, jobs are killed and rerun as soon as a dep they have read is modified
 //			Collect                                                                 collect             ;
 //			Console                                                                 console             ;
 //			bool                                                                    has_remote_backends = false ;
@@ -1486,6 +1502,7 @@ namespace Version {
 //			::vmap_ss        rsrcs        = {} ;
 //			JobStartRpcReq   pre_start    = {} ;
 //			JobStartRpcReply start        = {} ;
+//			::string         placement    = {} ; // cpus and memory nodes job was bound to by backend, if any
 //			// END_OF_VERSIONING
 //			// START_OF_VERSIONING REPO CACHE
 //			JobInfoStart                            start    ;
@@ -1732,6 +1749,8 @@ namespace Version {
 //			mutable Delay    exe_time       = {} ;                                     // average exe_time
 //			mutable uint64_t tokens1_32     = 0  ; static_assert(sizeof(Tokens1)<=4) ; // average number of tokens1 <<32
 //			mutable JobIdx   stats_weight   = 0  ;                                     // number of jobs used to compute average cost_per_token and exe_time
+//			mutable size_t   peak_mem       = 0  ;                                     // max peak memory (in bytes) used by ok jobs
+//			mutable uint16_t peak_cpu       = 0  ;                                     // max average number of cpus used by ok jobs
 //			// END_OF_VERSIONING
 //			// START_OF_VERSIONING REPO
 //			Crc   match ;
@@ -1802,6 +1821,8 @@ namespace Version {
 //				::serdes(s,cost_per_token        ) ;
 //				::serdes(s,exe_time              ) ;
 //				::serdes(s,stats_weight          ) ;
+//				::serdes(s,peak_mem              ) ;
+//				::serdes(s,peak_cpu              ) ;
 //			}
 //			// derived
 //			::serdes(s,stem_n_marks  ) ;
@@ -2016,6 +2037,7 @@ namespace Version {
 //	,	AddLiveOut // report missing live_out info (Req) or tell job_exec to send missing live_out info (Reply)
 //	,	Heartbeat
 //	,	Kill
+//	,	Suspend    // used in JobMngtRpcReply to signal job is waiting for direct deps and its resources are released
 //	} ;
 //	// END_OF_VERSIONING
 //	// START_OF_VERSIONING REPO CACHE
@@ -2128,9 +2150,12 @@ namespace Version {
 //		Tag     tag  = JobReasonTag::None ;
 //		// END_OF_VERSIONING
 //		// START_OF_VERSIONING REPO CACHE
-//		size_t            mem = 0  ; // in bytes
-//		Time::CoarseDelay cpu = {} ;
-//		Time::CoarseDelay job = {} ; // elapsed in job
+//		size_t            mem      = 0  ; // in bytes
+//		Time::CoarseDelay cpu      = {} ;
+//		Time::CoarseDelay job      = {} ; // elapsed in job
+//		size_t            io_read  = 0  ; // in bytes, read    from block devices
+//		size_t            io_write = 0  ; // in bytes, written to   block devices
+//		size_t            tmp      = 0  ; // in bytes, used in tmp dir at end of job, only measured when tmp dir is a tmpfs
 //		// END_OF_VERSIONING
 //		// START_OF_VERSIONING REPO CACHE
 //		using Base = ::variant< Hash::Crc , Disk::FileSig , Disk::FileInfo > ;
@@ -2194,6 +2219,9 @@ namespace Version {
 //		// START_OF_VERSIONING REPO CACHE
 //		AutodepEnv                              autodep_env      ;
 //		CacheRemoteSide                         cache            ;
+//		::string                                cgroup_s         ;                       // if non-empty, cgroup v2 dir under which a per-job cgroup is created
+//		size_t                                  cgroup_mem       = 0                   ; // in bytes, memory job is limited to within its cgroup, 0 means no limit
+//		uint32_t                                cgroup_cpu       = 0                   ; // number of cpus job is throttled to within its cgroup, 0 means no limit
 //		bool                                    chk_abs_paths    = false               ;
 //		ChrootInfo                              chroot_info      ;
 //		::string                                cmd              ;
@@ -2212,6 +2240,7 @@ namespace Version {
 //		uint8_t                                 nice             = 0                   ;
 //		::string                                phy_lmake_root_s ;
 //		::vmap_s<FileAction>                    pre_actions      ;
+//		KeyedService                            relay            ;                       // if non-empty, server service to which per-host relay connects (addr is server addr as seen by job)
 //		::string                                rule             ;                       // rule name
 //		SmallId                                 small_id         = 0                   ;
 //		::vmap<Re::Pattern,MatchFlags>          star_matches     ;                       // maps regexprs to flags
@@ -2220,7 +2249,9 @@ namespace Version {
 //		::string                                stdin            ;
 //		::string                                stdout           ;
 //		Time::Delay                             timeout          ;
+//		size_t                                  tmp_sz           = 0                   ; // in bytes, if non-zero, tmp dir is a tmpfs of this size
 //		bool                                    use_script       = false               ;
+//		bool                                    watch_deps       = false               ; // if true, job is killed and rerun as soon as a dep it has read is modified
 //		Zlvl                                    zlvl             {}                    ;
 //		// END_OF_VERSIONING
 //		// START_OF_VERSIONING REPO CACHE
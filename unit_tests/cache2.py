@@ -33,8 +33,9 @@ else :
 	import ut
 
 	os.makedirs( 'CACHE/LMAKE' , mode=stat.S_ISGID|stat.S_IRWXU|stat.S_IRWXG )
-	print(textwrap.dedent('''
-		size = 1<<20
+	print(textwrap.dedent(f'''
+		size    = 1<<20
+		tenants = {{ 'me' : {{ 'key_prefix':{os.getcwd()!r} }} }}
 	''')[1:],file=open('CACHE/LMAKE/config.py','w'))
 
 	ut.lmake( 'dut1','dut2','dut3' , early_rerun=2 , done=5 )
@@ -43,3 +44,8 @@ else :
 	os.system(f'mkdir bck ; mv LMAKE dut* dyn* bck')
 
 	ut.lmake( 'dut1','dut2','dut3' , hit_rerun=2 , hit_done=3 , done=2 )
+
+	tenant_lines = [ l.split() for l in os.popen('lcache_dump CACHE') if l.startswith('me ') ]
+	assert len(tenant_lines)==1 and int(tenant_lines[0][6])>0 , f'no hit recorded for tenant : {tenant_lines}'
+	download_lines = [ l.split() for l in os.popen('lcache_dump CACHE') if l.startswith('download ') ]
+	assert len(download_lines)==1 and int(download_lines[0][2])>0 , f'no download latency recorded : {download_lines}'
@@ -0,0 +1,51 @@
+# This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+# Copyright (c) 2023-2026 Doliam
+# This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+# This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+import lmake
+
+def cgroup_root() :
+	for l in open('/proc/mounts') :
+		_,mnt,typ,*_ = l.split()
+		if typ=='cgroup2' : return mnt
+	return None
+
+root   = cgroup_root()
+cgroup = f'{root}/lmake_ut_cgroup'
+
+if __name__!='__main__' :
+
+	from lmake.rules import Rule
+
+	lmake.manifest = ('Lmakefile.py',)
+
+	lmake.config.cgroup = cgroup
+
+	class Dut(Rule) :
+		target    = 'dut'
+		resources = { 'cpu':1 , 'mem':'100M' }
+		cmd       = 'cat /proc/self/cgroup'
+
+else :
+
+	import os
+	import subprocess as sp
+
+	import ut
+
+	try :
+		if not root : raise RuntimeError
+		os.makedirs(cgroup,exist_ok=True)
+	except :
+		print('cgroup v2 not available',file=open('skipped','w'))
+		exit()
+
+	ut.lmake( 'dut' , done=1 )
+	assert '/lmake_ut_cgroup/lmake-' in open('dut').read()                        # job was run in its own cgroup
+	assert not [ d for d in os.listdir(cgroup) if d.startswith('lmake-') ]       # which was removed when job ended
+
+	info = eval(sp.check_output(('lshow','-ip','dut'),universal_newlines=True))['dut']
+	assert 'cpu_time' in info and 'io_read' in info
+
+	os.rmdir(cgroup)
@@ -0,0 +1,45 @@
+# This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+# Copyright (c) 2023-2026 Doliam
+# This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+# This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+n = 10
+
+if __name__!='__main__' :
+
+	import lmake
+	from lmake.rules import Rule
+
+	lmake.manifest = ('Lmakefile.py',)
+
+	lmake.config.backends.local.direct_start = True
+
+	class Dut(Rule) :
+		target = r'dut{N:\d+}'
+		cmd    = 'echo {N}'
+
+	class Big(Rule) :                               # start info does not fit in a default pipe
+		target  = 'big'
+		environ = { f'BIG{i}':'x'*50000 for i in range(4) } # a single env var cannot be larger than 128k
+		cmd     = 'echo $BIG0$BIG1$BIG2$BIG3 | wc -c'
+
+	class Bad(Rule) :
+		target = 'bad'
+		cmd    = 'exit 1'
+
+	class All(Rule) :
+		target = 'all'
+		deps   = { f'D{i}':f'dut{i}' for i in range(n) }
+		cmd    = f"cat {' '.join(f'{{D{i}}}' for i in range(n))}"
+
+else :
+
+	import ut
+
+	ut.lmake( 'all' , done=n+1 )
+	assert open('all').read().split()==[str(i) for i in range(n)]
+
+	ut.lmake( 'big' , done=1 )
+	assert int(open('big').read())==200001  # including final newline
+
+	ut.lmake( 'bad' , failed=1 , rc=1 )
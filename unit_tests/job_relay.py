@@ -0,0 +1,84 @@
+# This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+# Copyright (c) 2023-2026 Doliam
+# This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+# This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+# SGE is mimicked by a few scripts that run jobs locally, as relay is not used for local jobs
+
+import lmake
+
+n = 10
+
+if __name__!='__main__' :
+
+	import os.path as osp
+
+	from lmake.rules import Rule
+
+	lmake.config.console.host_len = 0
+
+	lmake.manifest = ('Lmakefile.py',)
+
+	lmake.config.job_relay = True
+
+	lmake.config.backends.sge = {
+		'bin'  : osp.abspath('sge_bin' )
+	,	'root' : osp.abspath('sge_root')
+	}
+
+	class Dut(Rule) :
+		target    = r'dut{N:\d+}'
+		backend   = 'sge'
+		resources = {'mem':'20M'}
+		cmd       = 'grep -q @lmake_relay- /proc/net/unix && echo {N}' # relay is launched before job is started
+
+	class All(Rule) :
+		target = 'all'
+		deps   = { f'D{i}':f'dut{i}' for i in range(n) }
+		cmd    = f"cat {' '.join(f'{{D{i}}}' for i in range(n))}"
+
+else :
+
+	import os
+	import os.path as osp
+	import sys
+
+	if 'sge' not in lmake.backends :
+		print('sge not compiled in',file=open('skipped','w'))
+		exit()
+
+	import ut
+
+	os.makedirs('sge_bin' ,exist_ok=True)
+	os.makedirs('sge_root',exist_ok=True)
+	root = osp.abspath('sge_root')
+	hdr  = f'#!{sys.executable}\nimport os,subprocess as sp,sys\nroot = {root!r}\n'
+
+	open('sge_bin/qsub','w').write( hdr + '''
+args = sys.argv[1:]
+while args and args[0].startswith('-') :
+	if args.pop(0)!='-terse' : args.pop(0)
+try    : id = int(open(root+'/next_id').read())
+except : id = 1
+open(root+'/next_id','w').write(str(id+1))
+state = f'{root}/{id}.alive'
+open(state,'w').close()
+sp.Popen( ('sh','-c','"$@" ; rm "$0"',state,*args) , stdin=sp.DEVNULL , stdout=sp.DEVNULL , stderr=sp.DEVNULL , start_new_session=True )
+print(id)
+''')
+	open('sge_bin/qstat','w').write( hdr + '''
+alive = [ f.split('.')[0] for f in os.listdir(root) if f.endswith('.alive') ]
+if sys.argv[1]=='-j' :
+	sys.exit( 0 if sys.argv[2] in alive else 1 )
+print('<job_info>')
+for j in alive :
+	print(f'<job_list state="running"><JB_job_number>{j}</JB_job_number><state>r</state></job_list>')
+print('</job_info>')
+''')
+	open('sge_bin/qdel','w').write(hdr)
+	for f in ('qsub','qstat','qdel') : os.chmod(f'sge_bin/{f}',0o755)
+
+	ut.lmake( 'all' , done=n+1 )
+	assert open('all').read().split()==[str(i) for i in range(n)]
+
+	ut.lmake( 'all' , done=0 ) # check jobs ended correctly through relay
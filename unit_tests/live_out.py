@@ -21,9 +21,19 @@ if __name__!='__main__' :
 			> {DUT}
 		'''
 
+	class Chatty(Rule) :
+		targets = { 'DUT':'chatty' }
+		cmd     = 'for i in $(seq 10000) ; do echo line$i ; done ; > {DUT}'
+
 else :
 
+	import subprocess as sp
+
 	import ut
 
 	cnt = ut.lmake( '-o' , 'dut.1' , 'dut.2' , done=2 , **{'continue':...} )
 	assert cnt['continue'] in (0,1,2)
+
+	out   = sp.check_output(('lmake','-o','chatty'),universal_newlines=True)
+	lines = [ l.strip() for l in out.splitlines() if l.strip().startswith('line') ]
+	assert lines==[f'line{i}' for i in range(1,10001)],lines[:10]               # live output is coalesced but complete and in order
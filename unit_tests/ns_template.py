@@ -0,0 +1,43 @@
+# This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+# Copyright (c) 2023-2026 Doliam
+# This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+# This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+import lmake
+
+n = 5
+
+if __name__!='__main__' :
+
+	from lmake.rules import Rule
+
+	lmake.manifest = ('Lmakefile.py',)
+
+	class Dut(Rule) :
+		target     = r'dut{N:\d+}'
+		chroot_dir = '/'
+		tmp_view   = '/tmp'
+		views      = { '/lmake_ut_usr/' : '/usr/' }                       # job space only depends on rule, so it can be shared
+		cmd        = 'echo {N} >$TMPDIR/n ; ls /lmake_ut_usr/bin | grep -qx env && cat $TMPDIR/n'
+
+	class All(Rule) :
+		target = 'all'
+		deps   = { f'D{i}':f'dut{i}' for i in range(n) }
+		cmd    = f"cat {' '.join(f'{{D{i}}}' for i in range(n))}"
+
+else :
+
+	import subprocess as sp
+
+	import ut
+
+	ut.lmake( 'dut0' , done=1 )                                                   # build template first as concurrent jobs dont wait for it to be built
+	ut.lmake( 'all'  , done=n )
+	assert open('all').read().split()==[str(i) for i in range(n)]                 # tmp dir is private to each job
+
+	tmpls = set()
+	for i in range(n) :
+		trace = sp.check_output(('lshow','-u',f'dut{i}'),universal_newlines=True)
+		for l in trace.splitlines() :
+			if 'entered_namespace' in l : tmpls.add(l.split()[-1])
+	assert len(tmpls)==1 and '/open-lmake/ns/' in tmpls.pop(),tmpls             # all jobs share the same namespace template
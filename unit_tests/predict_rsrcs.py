@@ -0,0 +1,33 @@
+# This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+# Copyright (c) 2023-2026 Doliam
+# This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+# This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+import lmake
+
+if __name__!='__main__' :
+
+	from lmake.rules import Rule
+
+	lmake.manifest = ('Lmakefile.py',)
+
+	lmake.config.predict_resources = True
+
+	class Dut(Rule) :
+		target    = r'dut{N:\d+}'
+		resources = {'mem':'500M'}
+		cmd       = 'echo {N}'
+		def deps() : # ensure jobs are run in sequence so history is available
+			return { 'PREV' : f'dut{int(N)-1}' } if int(N)>1 else {}
+
+else :
+
+	import subprocess as sp
+
+	import ut
+
+	ut.lmake( 'dut2' , done=2 )
+	info = sp.run( ('lshow','-i','dut2') , stdout=sp.PIPE , universal_newlines=True , check=True ).stdout
+	mem  = [ l.split(':')[1].strip() for l in info.splitlines() if 'mem (allocated)' in l ]
+	assert len(mem)==1 and mem[0].endswith('M') and int(mem[0][:-1])<500 , info # dut2 is submitted with mem predicted from dut1
+
@@ -0,0 +1,102 @@
+# This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+# Copyright (c) 2023-2026 Doliam
+# This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+# This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+# SGE is mimicked by a few scripts that run jobs locally and log the calls they receive
+
+import lmake
+
+n = 20
+
+if __name__!='__main__' :
+
+	import os.path as osp
+
+	from lmake.rules import Rule
+
+	lmake.config.console.host_len = 0
+
+	lmake.manifest = ('Lmakefile.py',)
+
+	lmake.config.backends.sge = {
+		'bin'               : osp.abspath('sge_bin')
+	,	'root'              : osp.abspath('sge_root')
+	,	'n_max_queued_jobs' : n                       # ensure jobs are launched together
+	,	'use_arrays'        : True
+	}
+
+	class Dut(Rule) :
+		target    = r'dut{N:\d+}'
+		backend   = 'sge'
+		resources = {'mem':'20M'}
+		cmd       = 'echo {N}'
+
+	class All(Rule) :
+		target = 'all'
+		deps   = { f'D{i}':f'dut{i}' for i in range(n) }
+		cmd    = f"cat {' '.join(f'{{D{i}}}' for i in range(n))}"
+
+else :
+
+	import os
+	import os.path as osp
+	import sys
+
+	if 'sge' not in lmake.backends :
+		print('sge not compiled in',file=open('skipped','w'))
+		exit()
+
+	import ut
+
+	os.makedirs('sge_bin' ,exist_ok=True)
+	os.makedirs('sge_root',exist_ok=True)
+	root = osp.abspath('sge_root')
+	hdr  = f'#!{sys.executable}\nimport os,subprocess as sp,sys\nroot = {root!r}\nprint(*sys.argv[1:2],file=open(root+"/calls","a"))\n'
+
+	open('sge_bin/qsub','w').write( hdr + '''
+args  = sys.argv[1:]
+tasks = None
+while args and args[0].startswith('-') :
+	o = args.pop(0)
+	if o=='-terse' : continue
+	a = args.pop(0)
+	if o=='-t' : tasks = int(a.split('-')[1])
+try    : id = int(open(root+'/next_id').read())
+except : id = 1
+open(root+'/next_id','w').write(str(id+1))
+if tasks :
+	script = f'{root}/{id}.sh'
+	open(script,'w').write(sys.stdin.read())
+	print('qsub_tasks',tasks,file=open(root+'/calls','a'))
+	for t in range(1,tasks+1) :
+		state = f'{root}/{id}.{t}.alive'
+		open(state,'w').close()
+		sp.Popen( ('sh','-c','sh "$0" ; rm "$1"',script,state) , env={**os.environ,'SGE_TASK_ID':str(t)} , stdin=sp.DEVNULL , stdout=sp.DEVNULL , start_new_session=True )
+	print(f'{id}.1-{tasks}:1')
+else :
+	state = f'{root}/{id}.0.alive'
+	open(state,'w').close()
+	sp.Popen( ('sh','-c','"$@" ; rm "$0"',state,*args) , stdin=sp.DEVNULL , stdout=sp.DEVNULL , stderr=sp.DEVNULL , start_new_session=True )
+	print(id)
+''')
+	open('sge_bin/qstat','w').write( hdr + '''
+alive = [ f.split('.')[:2] for f in os.listdir(root) if f.endswith('.alive') ]
+if sys.argv[1]=='-j' :
+	sys.exit( 0 if any( j==sys.argv[2] for j,_ in alive ) else 1 )
+print('<job_info>')
+for j,t in alive :
+	print(f'<job_list state="running"><JB_job_number>{j}</JB_job_number><state>r</state>' + (f'<tasks>{t}</tasks>' if t!='0' else '') + '</job_list>')
+print('</job_info>')
+''')
+	open('sge_bin/qdel','w').write(hdr)
+	for f in ('qsub','qstat','qdel') : os.chmod(f'sge_bin/{f}',0o755)
+
+	ut.lmake( 'all' , done=n+1 )
+	assert open('all').read().split()==[str(i) for i in range(n)]
+
+	calls = open('sge_root/calls').read().splitlines()
+	qsubs = [ c for c in calls if c.startswith('-') ]                                   # qsub calls are logged with their first arg, i.e. -terse
+	tasks = [ int(c.split()[1]) for c in calls if c.startswith('qsub_tasks') ]
+	assert len(qsubs)<=len(tasks)+2 , calls                                             # 1 call to sense daemon, + maybe a job launched alone
+	assert sum(tasks)>=n-1          , calls
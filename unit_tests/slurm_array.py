@@ -0,0 +1,52 @@
+# This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+# Copyright (c) 2023-2026 Doliam
+# This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+# This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+import lmake
+
+n = 20
+
+if __name__!='__main__' :
+
+	from lmake.rules import Rule
+
+	lmake.config.backends.slurm = {
+		'use_arrays'        : True
+	,	'n_max_queued_jobs' : n    # ensure jobs are launched together
+	}
+
+	lmake.config.console.host_len = 0
+
+	lmake.manifest = ('Lmakefile.py',)
+
+	class Dut(Rule) :
+		target    = r'dut{N:\d+}'
+		backend   = 'slurm'
+		resources = {'mem':'20M'}
+		cmd       = 'echo {N}'
+
+	class Het(Rule) :                                # heterogeneous jobs cannot be arrays
+		target    = r'het{N:\d+}'
+		backend   = 'slurm'
+		resources = {'mem':'20M','mem:1':'10M'}
+		cmd       = 'echo {N}'
+
+	class All(Rule) :
+		target = 'all'
+		deps   = { f'{k}{i}':f'{k.lower()}{i}' for k in ('Dut','Het') for i in range(n) }
+		cmd    = f"cat {' '.join(f'{{{k}{i}}}' for k in ('Dut','Het') for i in range(n))}"
+
+else :
+
+	import ut
+
+	if 'slurm' not in lmake.backends :
+		print('slurm not compiled in',file=open('skipped','w'))
+		exit()
+	if not ut.has_slurm() :
+		print('slurm not available',file=open('skipped','w'))
+		exit()
+
+	ut.lmake( 'all' , done=2*n+1 )
+	assert open('all').read().split()==[str(i) for k in ('Dut','Het') for i in range(n)]
@@ -0,0 +1,34 @@
+# This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+# Copyright (c) 2023-2026 Doliam
+# This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+# This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+if __name__!='__main__' :
+
+	import signal
+
+	import lmake
+	from lmake.rules import Rule,PyRule
+
+	lmake.manifest = ('Lmakefile.py',)
+
+	lmake.config.backends.local.cpu         = 1                    # jobs cannot run in parallel, so dut can only progress if it releases its cpu while waiting for sub
+	lmake.config.backends.local.suspend_sig = int(signal.SIGUSR1)
+
+	class Sub(Rule) :
+		target = r'sub{N:\d+}'
+		cmd    = 'echo {N}'
+
+	class Dut(PyRule) :
+		target = 'dut'
+		def cmd() :
+			signal.signal( signal.SIGUSR1 , lambda sig,frame : print('suspended') )
+			lmake.depend('sub1',direct=True)
+			print(open('sub1').read(),end='')
+
+else :
+
+	import ut
+
+	ut.lmake( 'dut' , done=2 )
+	assert open('dut').read()=='suspended\n1\n'
@@ -0,0 +1,43 @@
+# This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+# Copyright (c) 2023-2026 Doliam
+# This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+# This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+import lmake
+
+if __name__!='__main__' :
+
+	from lmake.rules import Rule
+
+	lmake.manifest = ('Lmakefile.py',)
+
+	lmake.config.tmp_fs = True
+
+	class Dut(Rule) :
+		target    = 'dut'
+		resources = { 'tmp':'10M' }
+		cmd       = 'dd if=/dev/zero of=$TMPDIR/x bs=1M count=2 2>/dev/null ; stat -f -c %T $TMPDIR'
+
+	class Full(Rule) :
+		target    = 'full'
+		resources = { 'tmp':'1M' }
+		cmd       = 'dd if=/dev/zero of=$TMPDIR/x bs=1M count=2 2>/dev/null'
+
+	class Phy(Rule) :
+		target = 'phy'
+		cmd    = 'stat -f -c %T $TMPDIR'
+
+else :
+
+	import subprocess as sp
+
+	import ut
+
+	ut.lmake( 'dut' , 'phy' , done=2 )
+	assert open('dut').read().strip()=='tmpfs'                                   # tmp dir is a tmpfs when tmp resource is declared
+	assert open('phy').read().strip()!='tmpfs'                                   # and not otherwise
+
+	info = eval(sp.check_output(('lshow','-ip','dut'),universal_newlines=True))['dut']
+	assert int(info['used_tmp'])>=2<<20,info                                     # tmp usage is accounted
+
+	ut.lmake( 'full' , failed=1 , rc=1 )                                         # tmp usage is bounded by tmp resource
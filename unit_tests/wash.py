@@ -0,0 +1,51 @@
+# This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+# Copyright (c) 2023-2026 Doliam
+# This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+# This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+# many stale targets are washed in parallel
+
+n_dirs  = 10
+n_files = 50
+
+if __name__!='__main__' :
+
+	import lmake
+	from lmake.rules import Rule
+
+	lmake.manifest = (
+		'Lmakefile.py'
+	,	'src'
+	)
+
+	class Star(Rule) :
+		targets = { 'DST' : r'star/{*:\d+}/{*:\d+}' }
+		deps    = { 'SRC' : 'src'                   }
+		cmd = f'''
+			n=$(cat {{SRC}})
+			for d in $(seq {n_dirs}) ; do
+				mkdir -p star/$d
+				for f in $(seq $n) ; do echo $d.$f > star/$d/$f ; done
+			done
+		'''
+
+	class Dut(Rule) :
+		target = 'dut'
+		deps   = { 'D' : f'star/1/1' }
+		cmd    = 'cat {D}'
+
+else :
+
+	import os
+
+	import ut
+
+	print(n_files,file=open('src','w'))
+	ut.lmake( 'dut' , done=2 , new=1 )
+	assert all( len(os.listdir(f'star/{d}'))==n_files for d in range(1,n_dirs+1) )
+
+	open('star/2/2','w').write('bad')                                                # manually modified target is quarantined
+	print(1,file=open('src','w'))
+	ut.lmake( 'dut' , changed=1 , steady=1 )                                          # star/1/1 is unchanged, so dut is not rerun
+	assert all( os.listdir(f'star/{d}')==['1'] for d in range(1,n_dirs+1) )          # stale targets have been washed
+	assert open('LMAKE/quarantine/star/2/2').read()=='bad'
@@ -0,0 +1,47 @@
+# This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+# Copyright (c) 2023-2026 Doliam
+# This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+# This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+import os
+
+import lmake
+
+started = f'/tmp/lmake_ut_watch_deps.{os.getuid()}'                               # outside repo, so as not to be a target
+
+if __name__!='__main__' :
+
+	from lmake.rules import Rule
+
+	lmake.manifest = (
+		'Lmakefile.py'
+	,	'src'
+	)
+
+	lmake.config.watch_deps = True
+
+	class Dut(Rule) :
+		target = 'dut'
+		deps   = { 'SRC' : 'src' }
+		cmd    = f'cat {{SRC}} ; touch {started} ; [ $(cat {{SRC}}) = 1 ] && sleep 100 ; true' # long only with first version of src
+
+else :
+
+	import subprocess as sp
+	import time
+
+	import ut
+
+	if os.path.exists(started) : os.unlink(started)
+	print(1,file=open('src','w'))
+	start = time.time()
+	lmake = sp.Popen(('lmake','dut'))
+	while not os.path.exists(started) : time.sleep(0.1)
+	time.sleep(1)                                                                 # ensure job has read src
+	print(2,file=open('src','w'))                                                 # job is doomed, it must not run up to its end
+	rc = lmake.wait()
+	os.unlink(started)
+	assert time.time()-start<50,time.time()-start
+
+	ut.lmake( 'dut' , done=rc!=0 )                                                 # dut may have been rerun by first lmake command or not depending on src check
+	assert open('dut').read().strip()=='2'